@@ -18,6 +18,9 @@ extern void performance_profiling_puzzle_11();
 extern void performance_profiling_names_statistics_01();
 extern void performance_profiling_names_statistics_02();
 extern void performance_profiling_names_statistics_03();
+extern void performance_profiling_names_statistics_04();
+extern void performance_profiling_names_statistics_05();
+extern void performance_profiling_names_statistics_06();
 
 int main()
 {
@@ -37,6 +40,9 @@ int main()
     //performance_profiling_names_statistics_01();
     //performance_profiling_names_statistics_02();
     //performance_profiling_names_statistics_03();
+    //performance_profiling_names_statistics_04();
+    //performance_profiling_names_statistics_05();
+    //performance_profiling_names_statistics_06();
 
     return 0;
 }
@@ -0,0 +1,282 @@
+// ===========================================================================
+// Statistics_Firstnames_04.cpp // Profiling
+// From: Marc Gregoire, "Professional C++", 6.th Edition
+// Variant 04: Rank index - O(log n) rank queries
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace NamesStatistics_V04 {
+
+    // ===========================================================================
+    // Types
+
+    // Fenwick tree (binary indexed tree) over the counts:
+    // entry c holds the number of names, which occur exactly c times.
+    // Both the update of an entry and the sum of a prefix cost O(log maxCount).
+    class CountIndex
+    {
+    public:
+        CountIndex();
+
+        // 'names' more (or less, if negative) names with the given count
+        void add(int count, int names);
+
+        // number of names with a count greater than 'count'
+        int countGreater(int count) const;
+
+    private:
+        int prefixSum(int count) const;
+        void grow(int count);
+
+        std::vector<int> m_tree;        // 1-based, m_tree[0] is unused
+        std::vector<int> m_names;       // plain histogram, to rebuild the tree when growing
+        int              m_total;
+    };
+
+    class NameDB
+    {
+    public:
+
+        NameDB();
+
+        // Reads list of names in nameFile to populate the database.
+        // Throws invalid_argument if nameFile cannot be opened or read.
+        void init(const std::string& nameFile);
+
+        // Adds one occurrence of the name - the rank index is updated incrementally.
+        void addName(const std::string& name);
+
+        // Returns the rank of the name (1st, 2nd, etc).
+        // Returns -1 if the name is not found.
+        int getNameRank(const std::string& name) const;
+
+        // The linear scan of variant 03 - for comparison.
+        int getNameRankScan(const std::string& name) const;
+
+        // Returns the number of entries with a given name.
+        // Returns -1 if the name is not found.
+        int getAbsoluteNumber(const std::string& name) const;
+
+        // All names in the database.
+        std::vector<std::string> getNames() const;
+
+    private:
+        std::map<std::string, int> m_names;
+        CountIndex                 m_ranks;
+    };
+
+    // ===========================================================================
+    // Implementation - CountIndex
+
+    CountIndex::CountIndex() : m_tree(1), m_names(1), m_total{} {}
+
+    void CountIndex::add(int count, int names)
+    {
+        if (count >= static_cast<int>(m_tree.size())) {
+            grow(count);
+        }
+
+        m_names[count] += names;
+        m_total += names;
+
+        // the lowest set bit of the index is the size of the range of an entry
+        for (int i{ count }; i < static_cast<int>(m_tree.size()); i += i & -i) {
+            m_tree[i] += names;
+        }
+    }
+
+    int CountIndex::countGreater(int count) const
+    {
+        return m_total - prefixSum(count);
+    }
+
+    int CountIndex::prefixSum(int count) const
+    {
+        int sum{};
+
+        for (int i{ std::min(count, static_cast<int>(m_tree.size()) - 1) }; i > 0; i -= i & -i) {
+            sum += m_tree[i];
+        }
+
+        return sum;
+    }
+
+    // doubles the size - the tree is rebuilt in O(n) from the histogram
+    void CountIndex::grow(int count)
+    {
+        std::size_t size{ m_tree.size() };
+        while (size <= static_cast<std::size_t>(count)) {
+            size *= 2;
+        }
+
+        m_names.resize(size);
+        m_tree.assign(m_names.begin(), m_names.end());
+
+        for (std::size_t i{ 1 }; i < size; ++i) {
+            const std::size_t parent{ i + (i & (~i + 1)) };
+            if (parent < size) {
+                m_tree[parent] += m_tree[i];
+            }
+        }
+    }
+
+    // ===========================================================================
+    // Implementation - NameDB
+
+    NameDB::NameDB() {}
+
+    // Reads list of names in nameFile to populate the database.
+    // Throws invalid_argument if nameFile cannot be opened or read.
+    void NameDB::init(const std::string& nameFile) {
+        // Open the file and check for errors.
+        std::ifstream inputFile{ nameFile };
+        if (!inputFile) {
+            throw std::invalid_argument{ "Unable to open file" };
+        }
+
+        // Read the names one at a time.
+        std::string name;
+        while (inputFile >> name) {
+            addName(name);
+        }
+    }
+
+    // The name moves from its old count to the new one.
+    void NameDB::addName(const std::string& name)
+    {
+        int& count{ m_names[name] };
+
+        if (count != 0) {
+            m_ranks.add(count, -1);
+        }
+
+        ++count;
+        m_ranks.add(count, 1);
+    }
+
+    // Returns the rank of the name.
+    // The number of names with a higher count is a query of the rank index.
+    int NameDB::getNameRank(const std::string& name) const
+    {
+        int num{ getAbsoluteNumber(name) };
+
+        // Check if we found the name.
+        if (num == -1) {
+            return -1;
+        }
+
+        return 1 + m_ranks.countGreater(num);
+    }
+
+    int NameDB::getNameRankScan(const std::string& name) const
+    {
+        int num{ getAbsoluteNumber(name) };
+
+        if (num == -1) {
+            return -1;
+        }
+
+        int rank{ 1 };
+        for (auto& entry : m_names) {
+            if (entry.second > num) {
+                ++rank;
+            }
+        }
+
+        return rank;
+    }
+
+    // Returns the count associated with the given name.
+    int NameDB::getAbsoluteNumber(const std::string& name) const
+    {
+        auto res{ m_names.find(name) };
+        if (res != end(m_names)) {
+            return res->second;
+        }
+
+        return -1;
+    }
+
+    std::vector<std::string> NameDB::getNames() const
+    {
+        std::vector<std::string> names;
+        names.reserve(m_names.size());
+
+        for (const auto& entry : m_names) {
+            names.push_back(entry.first);
+        }
+
+        return names;
+    }
+}
+
+// ===========================================================================
+// Test Frame
+
+#ifdef _DEBUG
+static constexpr std::size_t NumRankQueries = 10'000;       // debug
+#else
+static constexpr std::size_t NumRankQueries = 1'000'000;    // release
+#endif
+
+void performance_profiling_names_statistics_04()
+{
+    using namespace NamesStatistics_V04;
+
+    NameDB boys{};
+
+    {
+        ScopedTimer watch{};
+
+        boys.init("Names_Long.txt");
+
+        std::println("{}", boys.getNameRank("Daniel"));
+        std::println("{}", boys.getNameRank("Jacob"));
+        std::println("{}", boys.getNameRank("William"));
+    }
+
+    const std::vector<std::string> names{ boys.getNames() };
+
+    bool same{ true };
+    for (const std::string& name : names) {
+        same = same && boys.getNameRank(name) == boys.getNameRankScan(name);
+    }
+
+    std::println("{} rank queries - {} names - same ranks: {}", NumRankQueries, names.size(), same);
+
+    long long sum{};
+
+    std::println("Linear scan:");
+    {
+        ScopedTimer watch{};
+
+        for (std::size_t i{}; i != NumRankQueries; ++i) {
+            sum += boys.getNameRankScan(names[i % names.size()]);
+        }
+    }
+
+    std::println("Rank index:");
+    {
+        ScopedTimer watch{};
+
+        for (std::size_t i{}; i != NumRankQueries; ++i) {
+            sum += boys.getNameRank(names[i % names.size()]);
+        }
+    }
+
+    std::println("(checksum: {})", sum);
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,427 @@
+// ===========================================================================
+// Statistics_Firstnames_05.cpp // Profiling
+// From: Marc Gregoire, "Professional C++", 6.th Edition
+// Variant 05: Fast loading - memory-mapped, parallel parsing, binary snapshot
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "../Performance_Optimization_Advanced/MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace NamesStatistics_V05 {
+
+    // ===========================================================================
+    // Types
+
+    // The database is a read-only table, which is built once:
+    //
+    //   pool      all names back to back, in sorted order
+    //   entries   per name: offset and length in the pool, count - sorted by name,
+    //             a name is found with a binary search
+    //   counts    all counts in descending order - the rank of a count is a binary search
+    //
+    // The three arrays are either built from a text file (memory-mapped, parsed in
+    // parallel) or used directly from a memory-mapped snapshot file - no parsing at all.
+
+    class NameDB
+    {
+    public:
+        struct Entry
+        {
+            std::uint32_t m_offset;
+            std::uint32_t m_length;
+            std::int32_t  m_count;
+        };
+
+        NameDB();
+
+        // Reads list of names in nameFile to populate the database.
+        // The file is mapped into memory and split into one chunk per thread.
+        // Throws invalid_argument if nameFile cannot be opened or read.
+        void init(const std::string& nameFile, std::size_t numThreads = 0);
+
+        // Writes the database to a binary snapshot.
+        // Throws runtime_error if the snapshot cannot be written.
+        void writeSnapshot(const std::string& snapshotFile) const;
+
+        // Maps a snapshot into memory - the database uses it in place.
+        // Throws invalid_argument if snapshotFile is no valid snapshot.
+        void loadSnapshot(const std::string& snapshotFile);
+
+        // Returns the rank of the name (1st, 2nd, etc).
+        // Returns -1 if the name is not found.
+        int getNameRank(std::string_view name) const;
+
+        // Returns the number of entries with a given name.
+        // Returns -1 if the name is not found.
+        int getAbsoluteNumber(std::string_view name) const;
+
+        std::size_t size() const { return m_entries.size(); }
+
+    private:
+        struct Header
+        {
+            char          m_magic[8];
+            std::uint64_t m_numNames;
+            std::uint64_t m_poolSize;
+        };
+
+        std::string_view nameOf(const Entry& entry) const {
+            return m_pool.substr(entry.m_offset, entry.m_length);
+        }
+
+        void build(const std::unordered_map<std::string_view, int>& counts);
+
+        // the active data - owned or in the mapped snapshot
+        std::span<const Entry>         m_entries;
+        std::span<const std::int32_t>  m_counts;
+        std::string_view               m_pool;
+
+        // owned data
+        std::vector<Entry>             m_ownEntries;
+        std::vector<std::int32_t>      m_ownCounts;
+        std::string                    m_ownPool;
+
+        MemoryMappedFile               m_snapshot;
+    };
+
+    static constexpr char SnapshotMagic[8]{ 'N', 'A', 'M', 'E', 'D', 'B', '0', '1' };
+
+    static bool isSpace(char ch)
+    {
+        return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+    }
+
+    // counts the whitespace separated names of 'text' - the keys are views into 'text'
+    static void countNames(std::string_view text, std::unordered_map<std::string_view, int>& counts)
+    {
+        std::size_t pos{};
+
+        while (pos != text.size()) {
+
+            while (pos != text.size() && isSpace(text[pos])) {
+                ++pos;
+            }
+
+            const std::size_t begin{ pos };
+
+            while (pos != text.size() && !isSpace(text[pos])) {
+                ++pos;
+            }
+
+            if (pos != begin) {
+                ++counts[text.substr(begin, pos - begin)];
+            }
+        }
+    }
+
+    // ===========================================================================
+    // Implementation
+
+    NameDB::NameDB() {}
+
+    void NameDB::init(const std::string& nameFile, std::size_t numThreads)
+    {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        MemoryMappedFile file{};
+        if (!file.open(nameFile)) {
+            throw std::invalid_argument{ "Unable to open file" };
+        }
+
+        const std::string_view text{ file.view() };
+
+        // chunk boundaries behind a line break - no name is split
+        std::vector<std::size_t> bounds{ 0 };
+        for (std::size_t i{ 1 }; i < numThreads; ++i) {
+            std::size_t pos{ std::max(bounds.back(), text.size() / numThreads * i) };
+            while (pos != text.size() && text[pos] != '\n') {
+                ++pos;
+            }
+            bounds.push_back(pos);
+        }
+        bounds.push_back(text.size());
+
+        // one map per thread, no locking
+        std::vector<std::unordered_map<std::string_view, int>> counts(numThreads);
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t t{ 1 }; t < numThreads; ++t) {
+                threads.emplace_back([&, t] () {
+                    countNames(text.substr(bounds[t], bounds[t + 1] - bounds[t]), counts[t]);
+                });
+            }
+
+            countNames(text.substr(bounds[0], bounds[1] - bounds[0]), counts[0]);
+        }
+
+        for (std::size_t t{ 1 }; t < numThreads; ++t) {
+            for (const auto& [name, count] : counts[t]) {
+                counts[0][name] += count;
+            }
+        }
+
+        // the table owns its strings - the mapping of the text file is released
+        build(counts[0]);
+    }
+
+    void NameDB::build(const std::unordered_map<std::string_view, int>& counts)
+    {
+        std::vector<std::pair<std::string_view, int>> sorted{ counts.begin(), counts.end() };
+        std::sort(sorted.begin(), sorted.end());
+
+        m_ownPool.clear();
+        m_ownEntries.clear();
+        m_ownCounts.clear();
+
+        m_ownEntries.reserve(sorted.size());
+        m_ownCounts.reserve(sorted.size());
+
+        for (const auto& [name, count] : sorted) {
+            m_ownEntries.push_back(Entry{ static_cast<std::uint32_t>(m_ownPool.size()), static_cast<std::uint32_t>(name.size()), count });
+            m_ownCounts.push_back(count);
+            m_ownPool += name;
+        }
+
+        std::sort(m_ownCounts.begin(), m_ownCounts.end(), std::greater<>{});
+
+        m_snapshot = MemoryMappedFile{};
+        m_entries = m_ownEntries;
+        m_counts = m_ownCounts;
+        m_pool = m_ownPool;
+    }
+
+    // Snapshot format (native byte order, each section 8 byte aligned):
+    //   header, entries, counts (descending), pool
+    void NameDB::writeSnapshot(const std::string& snapshotFile) const
+    {
+        std::ofstream out{ snapshotFile, std::ios::binary | std::ios::trunc };
+        if (!out) {
+            throw std::runtime_error{ "Unable to write snapshot" };
+        }
+
+        Header header{};
+        std::memcpy(header.m_magic, SnapshotMagic, sizeof(SnapshotMagic));
+        header.m_numNames = m_entries.size();
+        header.m_poolSize = m_pool.size();
+
+        auto pad = [&] () {
+            while (out.tellp() % 8 != 0) {
+                out.put('\0');
+            }
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(m_entries.data()), static_cast<std::streamsize>(m_entries.size_bytes()));
+        pad();
+        out.write(reinterpret_cast<const char*>(m_counts.data()), static_cast<std::streamsize>(m_counts.size_bytes()));
+        pad();
+        out.write(m_pool.data(), static_cast<std::streamsize>(m_pool.size()));
+
+        if (!out.flush()) {
+            throw std::runtime_error{ "Unable to write snapshot" };
+        }
+    }
+
+    void NameDB::loadSnapshot(const std::string& snapshotFile)
+    {
+        MemoryMappedFile file{};
+        if (!file.open(snapshotFile) || file.size() < sizeof(Header)) {
+            throw std::invalid_argument{ "Unable to open snapshot" };
+        }
+
+        Header header{};
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        // the header is untrusted: bound the counts before they are multiplied
+        if (header.m_numNames > file.size() / sizeof(Entry) || header.m_poolSize > file.size()) {
+            throw std::invalid_argument{ "No valid snapshot" };
+        }
+
+        auto alignTo8 = [] (std::size_t offset) { return (offset + 7) & ~std::size_t{ 7 }; };
+
+        const std::size_t entriesOffset{ sizeof(Header) };
+        const std::size_t countsOffset{ alignTo8(entriesOffset + header.m_numNames * sizeof(Entry)) };
+        const std::size_t poolOffset{ alignTo8(countsOffset + header.m_numNames * sizeof(std::int32_t)) };
+
+        if (std::memcmp(header.m_magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 || poolOffset + header.m_poolSize > file.size()) {
+            throw std::invalid_argument{ "No valid snapshot" };
+        }
+
+        // the sections are used in place: the mapping is page aligned, the sections 8 byte aligned
+        const std::byte* base{ file.data() };
+        const auto numNames{ static_cast<std::size_t>(header.m_numNames) };
+
+        m_entries = { reinterpret_cast<const Entry*>(base + entriesOffset), numNames };
+        m_counts = { reinterpret_cast<const std::int32_t*>(base + countsOffset), numNames };
+        m_pool = { reinterpret_cast<const char*>(base + poolOffset), static_cast<std::size_t>(header.m_poolSize) };
+
+        m_ownEntries.clear();
+        m_ownCounts.clear();
+        m_ownPool.clear();
+
+        // moving the mapping doesn't move the mapped memory - the views stay valid
+        m_snapshot = std::move(file);
+    }
+
+    // Returns the rank of the name: 1 + the number of counts greater than its count.
+    int NameDB::getNameRank(std::string_view name) const
+    {
+        int num{ getAbsoluteNumber(name) };
+
+        // Check if we found the name.
+        if (num == -1) {
+            return -1;
+        }
+
+        // the counts are in descending order: the greater ones come first
+        auto pos{ std::lower_bound(m_counts.begin(), m_counts.end(), num, std::greater<>{}) };
+        return 1 + static_cast<int>(pos - m_counts.begin());
+    }
+
+    // Returns the count associated with the given name.
+    int NameDB::getAbsoluteNumber(std::string_view name) const
+    {
+        auto pos{ std::lower_bound(m_entries.begin(), m_entries.end(), name,
+            [this] (const Entry& entry, std::string_view name) { return nameOf(entry) < name; }
+        ) };
+
+        if (pos != m_entries.end() && nameOf(*pos) == name) {
+            return pos->m_count;
+        }
+
+        return -1;
+    }
+}
+
+// ===========================================================================
+// Test Frame
+
+#ifdef _DEBUG
+static constexpr int Copies = 1;     // debug
+#else
+static constexpr int Copies = 10;    // release
+#endif
+
+void performance_profiling_names_statistics_05()
+{
+    using namespace NamesStatistics_V05;
+
+    {
+        ScopedTimer watch{};
+
+        NameDB boys{};
+        boys.init("Names_Long.txt");
+
+        std::println("{}", boys.getNameRank("Daniel"));
+        std::println("{}", boys.getNameRank("Jacob"));
+        std::println("{}", boys.getNameRank("William"));
+    }
+
+    // a larger name list: copies of Names_Long.txt
+    const std::string namesFile{ (std::filesystem::temp_directory_path() / "Names_Huge.txt").string() };
+    const std::string snapshotFile{ (std::filesystem::temp_directory_path() / "Names_Huge.namedb").string() };
+
+    {
+        std::ifstream in{ "Names_Long.txt", std::ios::binary };
+        const std::string names{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+
+        std::ofstream out{ namesFile, std::ios::binary | std::ios::trunc };
+        for (int i{}; i != Copies; ++i) {
+            out << names;
+        }
+    }
+
+    std::println("{}: {} bytes", namesFile, std::filesystem::file_size(namesFile));
+
+    int rank{ 1 };
+
+    std::println("std::map, operator>> (variants 02 - 04):");
+    {
+        ScopedTimer watch{};
+
+        std::map<std::string, int> names;
+
+        std::ifstream inputFile{ namesFile };
+        std::string name;
+        while (inputFile >> name) {
+            names[name] += 1;
+        }
+
+        for (const auto& entry : names) {
+            if (entry.second > names["Daniel"]) {
+                ++rank;
+            }
+        }
+
+        std::println("{} names", names.size());
+    }
+
+    std::println("Memory-mapped, parallel parsing, sorted table:");
+    {
+        ScopedTimer watch{};
+
+        NameDB boys{};
+        boys.init(namesFile);
+
+        std::println("{} names - same rank: {}", boys.size(), boys.getNameRank("Daniel") == rank);
+
+        boys.writeSnapshot(snapshotFile);
+    }
+
+    std::println("Snapshot: {} bytes", std::filesystem::file_size(snapshotFile));
+
+    std::println("Loading the snapshot:");
+    {
+        ScopedTimer watch{};
+
+        NameDB boys{};
+        boys.loadSnapshot(snapshotFile);
+
+        std::println("{} names - same rank: {}", boys.size(), boys.getNameRank("Daniel") == rank);
+    }
+
+    // a corrupt header: numNames * sizeof(Entry) overflows - the offsets would wrap around
+    {
+        std::fstream file{ snapshotFile, std::ios::binary | std::ios::in | std::ios::out };
+        const std::uint64_t numNames{ std::uint64_t{ 1 } << 62 };
+        file.seekp(8);
+        file.write(reinterpret_cast<const char*>(&numNames), sizeof(numNames));
+    }
+
+    try {
+        NameDB boys{};
+        boys.loadSnapshot(snapshotFile);
+        std::println("Corrupt snapshot accepted!");
+    }
+    catch (const std::invalid_argument& e) {
+        std::println("Corrupt snapshot rejected: {}", e.what());
+    }
+
+    std::filesystem::remove(namesFile);
+    std::filesystem::remove(snapshotFile);
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,353 @@
+// ===========================================================================
+// Statistics_Firstnames_06.cpp // Profiling
+// From: Marc Gregoire, "Professional C++", 6.th Edition
+// Variant 06: Batched queries - flat hash table, software prefetching
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace NamesStatistics_V06 {
+
+    // ===========================================================================
+    // Types
+
+    // The names are stored in a flat, open addressing hash table (linear probing).
+    // A query of a single name waits for the cache miss of its slot -
+    // a batch of queries computes the slots of all names first and prefetches them,
+    // so the cache misses of the batch overlap.
+    //
+    // The rank of each name is computed once, when the table is built.
+
+    class NameDB
+    {
+    public:
+        NameDB();
+
+        // Reads list of names in nameFile to populate the database.
+        // Throws invalid_argument if nameFile cannot be opened or read.
+        void init(const std::string& nameFile);
+
+        // Returns the rank of the name (1st, 2nd, etc).
+        // Returns -1 if the name is not found.
+        int getNameRank(std::string_view name) const;
+
+        // Returns the number of entries with a given name.
+        // Returns -1 if the name is not found.
+        int getAbsoluteNumber(std::string_view name) const;
+
+        // Batched versions: one result per name, -1 if the name is not found.
+        std::vector<int> getNameRanks(std::span<const std::string_view> names) const;
+        std::vector<int> getAbsoluteNumbers(std::span<const std::string_view> names) const;
+
+        std::size_t size() const { return m_size; }
+
+    private:
+        struct Slot
+        {
+            std::uint64_t m_hash;
+            std::uint32_t m_offset;     // of the name in the pool
+            std::uint32_t m_length;
+            std::int32_t  m_count;      // 0: empty slot
+            std::int32_t  m_rank;
+        };
+
+        // number of queries, whose slots are prefetched ahead
+        static constexpr std::size_t BatchSize{ 16 };
+
+        static std::uint64_t hashOf(std::string_view name) {
+            return std::hash<std::string_view>{}(name);
+        }
+
+        const Slot* find(std::string_view name, std::uint64_t hash) const;
+
+        template <typename TResult>
+        std::vector<int> lookupBatch(std::span<const std::string_view> names, TResult result) const;
+
+        std::vector<Slot>  m_slots;     // power of 2
+        std::string        m_pool;
+        std::size_t        m_size;
+    };
+
+    static void prefetch(const void* address)
+    {
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void) address;
+#endif
+    }
+
+    // ===========================================================================
+    // Implementation
+
+    NameDB::NameDB() : m_size{} {}
+
+    void NameDB::init(const std::string& nameFile)
+    {
+        // Open the file and check for errors.
+        std::ifstream inputFile{ nameFile };
+        if (!inputFile) {
+            throw std::invalid_argument{ "Unable to open file" };
+        }
+
+        // Read the names one at a time.
+        std::unordered_map<std::string, int> names;
+        std::string name;
+        while (inputFile >> name) {
+            ++names[name];
+        }
+
+        // the ranks: 1 + the number of names with a greater count
+        std::vector<int> counts;
+        counts.reserve(names.size());
+        for (const auto& entry : names) {
+            counts.push_back(entry.second);
+        }
+        std::sort(counts.begin(), counts.end(), std::greater<>{});
+
+        // load factor at most 1/2 - short probe sequences
+        m_size = names.size();
+        m_slots.assign(std::bit_ceil(std::max<std::size_t>(2 * m_size, 16)), Slot{});
+        m_pool.clear();
+
+        const std::size_t mask{ m_slots.size() - 1 };
+
+        for (const auto& [name, count] : names) {
+
+            const std::uint64_t hash{ hashOf(name) };
+
+            std::size_t index{ hash & mask };
+            while (m_slots[index].m_count != 0) {
+                index = (index + 1) & mask;
+            }
+
+            auto pos{ std::lower_bound(counts.begin(), counts.end(), count, std::greater<>{}) };
+
+            m_slots[index] = Slot{
+                hash,
+                static_cast<std::uint32_t>(m_pool.size()),
+                static_cast<std::uint32_t>(name.size()),
+                count,
+                1 + static_cast<int>(pos - counts.begin())
+            };
+
+            m_pool += name;
+        }
+    }
+
+    const NameDB::Slot* NameDB::find(std::string_view name, std::uint64_t hash) const
+    {
+        if (m_slots.empty()) {
+            return nullptr;
+        }
+
+        const std::size_t mask{ m_slots.size() - 1 };
+
+        for (std::size_t index{ hash & mask }; m_slots[index].m_count != 0; index = (index + 1) & mask) {
+
+            const Slot& slot{ m_slots[index] };
+
+            // the hash first - the name in the pool is another cache line
+            if (slot.m_hash == hash && std::string_view{ m_pool }.substr(slot.m_offset, slot.m_length) == name) {
+                return &slot;
+            }
+        }
+
+        return nullptr;
+    }
+
+    int NameDB::getNameRank(std::string_view name) const
+    {
+        const Slot* slot{ find(name, hashOf(name)) };
+        return slot != nullptr ? slot->m_rank : -1;
+    }
+
+    int NameDB::getAbsoluteNumber(std::string_view name) const
+    {
+        const Slot* slot{ find(name, hashOf(name)) };
+        return slot != nullptr ? slot->m_count : -1;
+    }
+
+    std::vector<int> NameDB::getNameRanks(std::span<const std::string_view> names) const
+    {
+        return lookupBatch(names, [] (const Slot& slot) { return slot.m_rank; });
+    }
+
+    std::vector<int> NameDB::getAbsoluteNumbers(std::span<const std::string_view> names) const
+    {
+        return lookupBatch(names, [] (const Slot& slot) { return slot.m_count; });
+    }
+
+    // Per block of 'BatchSize' names: 1. hash all names and prefetch their slots,
+    // 2. resolve them - by now the slots are (or are being) loaded into the cache.
+    template <typename TResult>
+    std::vector<int> NameDB::lookupBatch(std::span<const std::string_view> names, TResult result) const
+    {
+        std::vector<int> results(names.size(), -1);
+
+        if (m_slots.empty()) {
+            return results;
+        }
+
+        const std::size_t mask{ m_slots.size() - 1 };
+        std::uint64_t hashes[BatchSize];
+
+        for (std::size_t begin{}; begin < names.size(); begin += BatchSize) {
+
+            const std::size_t end{ std::min(begin + BatchSize, names.size()) };
+
+            for (std::size_t i{ begin }; i != end; ++i) {
+                hashes[i - begin] = hashOf(names[i]);
+                prefetch(&m_slots[hashes[i - begin] & mask]);
+            }
+
+            for (std::size_t i{ begin }; i != end; ++i) {
+                const Slot* slot{ find(names[i], hashes[i - begin]) };
+                if (slot != nullptr) {
+                    results[i] = result(*slot);
+                }
+            }
+        }
+
+        return results;
+    }
+}
+
+// ===========================================================================
+// Test Frame
+
+#ifdef _DEBUG
+static constexpr std::size_t NumNames = 10'000;         // debug
+static constexpr std::size_t NumQueries = 100'000;      // debug
+#else
+static constexpr std::size_t NumNames = 1'000'000;      // release
+static constexpr std::size_t NumQueries = 10'000'000;   // release
+#endif
+
+void performance_profiling_names_statistics_06()
+{
+    using namespace NamesStatistics_V06;
+
+    {
+        ScopedTimer watch{};
+
+        NameDB boys{};
+        boys.init("Names_Long.txt");
+
+        std::println("{}", boys.getNameRank("Daniel"));
+        std::println("{}", boys.getNameRank("Jacob"));
+        std::println("{}", boys.getNameRank("William"));
+    }
+
+    // a database, which doesn't fit into the cache: 'NumNames' distinct names,
+    // the i-th of them occurs (i % 7) + 1 times
+    const std::string namesFile{ (std::filesystem::temp_directory_path() / "Names_Distinct.txt").string() };
+
+    std::vector<std::string> names;
+    names.reserve(NumNames);
+
+    {
+        std::ofstream out{ namesFile, std::ios::trunc };
+
+        for (std::size_t i{}; i != NumNames; ++i) {
+
+            names.push_back("Name_" + std::to_string(i * 2654435761u % 4294967291u));
+
+            for (std::size_t k{}; k <= i % 7; ++k) {
+                out << names.back() << '\n';
+            }
+        }
+    }
+
+    NameDB db{};
+    db.init(namesFile);
+
+    std::map<std::string, int, std::less<>> tree;
+    for (std::size_t i{}; i != NumNames; ++i) {
+        tree[names[i]] = static_cast<int>(i % 7) + 1;
+    }
+
+    std::filesystem::remove(namesFile);
+
+    // random queries, some of them for unknown names
+    std::vector<std::string_view> queries;
+    queries.reserve(NumQueries);
+
+    std::uint64_t random{ 12345 };
+    for (std::size_t i{}; i != NumQueries; ++i) {
+        random = random * 6364136223846793005ull + 1442695040888963407ull;
+        queries.push_back((i % 10 == 9) ? std::string_view{ "Unknown" } : std::string_view{ names[(random >> 33) % NumNames] });
+    }
+
+    std::println("{} names - {} queries:", db.size(), NumQueries);
+
+    long long sumTree{};
+    long long sumSingle{};
+    long long sumBatch{};
+
+    std::println("std::map, one query at a time:");
+    {
+        ScopedTimer watch{};
+
+        for (std::string_view name : queries) {
+            auto res{ tree.find(name) };
+            sumTree += (res != tree.end()) ? res->second : -1;
+        }
+    }
+
+    std::println("Hash table, one query at a time:");
+    {
+        ScopedTimer watch{};
+
+        for (std::string_view name : queries) {
+            sumSingle += db.getAbsoluteNumber(name);
+        }
+    }
+
+    std::println("Hash table, batched with prefetching:");
+    {
+        ScopedTimer watch{};
+
+        for (int count : db.getAbsoluteNumbers(queries)) {
+            sumBatch += count;
+        }
+    }
+
+    std::println("Same counts: {}", sumTree == sumSingle && sumSingle == sumBatch);
+
+    // the ranks: single and batched queries must agree
+    const std::vector<int> ranks{ db.getNameRanks(std::span{ queries }.first(std::min<std::size_t>(queries.size(), 1000))) };
+
+    bool same{ true };
+    for (std::size_t i{}; i != ranks.size(); ++i) {
+        same = same && ranks[i] == db.getNameRank(queries[i]);
+    }
+
+    std::println("Same ranks:  {}", same);
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
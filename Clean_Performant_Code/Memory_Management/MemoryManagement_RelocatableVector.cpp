@@ -0,0 +1,207 @@
+// ===========================================================================
+// MemoryManagement_RelocatableVector.cpp // Memory Management
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "RelocatableVector.h"
+
+#include "../Person/Person.h"
+
+#include <cstddef>
+#include <memory>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Person opts in: it consists of two std::string objects and a size_t
+namespace Relocation {
+
+    template <>
+    struct is_trivially_relocatable<Person>
+        : std::bool_constant<is_trivially_relocatable_v<std::string>> {};
+}
+
+namespace RelocatableVector_Examples {
+
+    using namespace Relocation;
+
+    static void relocatable_vector_01()
+    {
+        std::println("is_trivially_relocatable<int>:                  {}", is_trivially_relocatable_v<int>);
+        std::println("is_trivially_relocatable<std::string>:          {}", is_trivially_relocatable_v<std::string>);
+        std::println("is_trivially_relocatable<std::vector<int>>:     {}", is_trivially_relocatable_v<std::vector<int>>);
+        std::println("is_trivially_relocatable<std::unique_ptr<int>>: {}", is_trivially_relocatable_v<std::unique_ptr<int>>);
+        std::println("is_trivially_relocatable<Person>:               {}", is_trivially_relocatable_v<Person>);
+    }
+
+    static void relocatable_vector_02()
+    {
+        RelocatableVector<std::string> vec;
+
+        vec.push_back("Of all the things I've lost, I miss my mind the most");
+        vec.push_back("DEF");
+        vec.insert(vec.begin(), "ABC");
+        vec.emplace(vec.begin() + 1, 5, '!');
+        vec.erase(vec.begin() + 2);
+
+        for (const auto& s : vec) {
+            std::println("{}", s);
+        }
+    }
+
+    static void relocatable_vector_03()
+    {
+        RelocatableVector<Person> vec;
+
+        vec.emplace_back("Hans", "Mueller", static_cast<size_t>(30));
+        vec.emplace_back("Sepp", "Meier", static_cast<size_t>(40));
+        vec.insert(vec.begin(), Person{ "Susi", "Wagner", static_cast<size_t>(50) });
+
+        for (const auto& person : vec) {
+            std::println("{}", person);
+        }
+    }
+
+    static void relocatable_vector_04()
+    {
+        // insert in the middle - in particular into a full vector, where the
+        // elements are relocated around the new one into the new block
+        RelocatableVector<std::unique_ptr<int>> pointers;
+        RelocatableVector<int> values;
+        std::vector<int> expected;
+        std::vector<int> order;
+
+        bool correct{ true };
+
+        for (int i{}; i != 100; ++i) {
+
+            const std::size_t pos{ expected.size() / 2 };
+
+            pointers.insert(pointers.begin() + pos, std::make_unique<int>(i));
+            order.insert(order.begin() + pos, i);
+
+            // an element of the vector itself as argument
+            const int& last{ values.empty() ? i : values[values.size() - 1] };
+            const int value{ last };
+            values.insert(values.begin() + pos, last);
+
+            expected.insert(expected.begin() + pos, value);
+
+            for (std::size_t k{}; k != expected.size(); ++k) {
+                correct = correct && values[k] == expected[k];
+            }
+        }
+
+        for (std::size_t k{}; k != pointers.size(); ++k) {
+            correct = correct && *pointers[k] == order[k];
+        }
+
+        std::println("Size: {} - Capacity: {} - insert correct: {}", values.size(), values.capacity(), correct);
+    }
+}
+
+namespace RelocatableVector_Benchmark {
+
+    using namespace Relocation;
+
+#ifdef _DEBUG
+    static constexpr std::size_t Iterations = 100'000;        // debug
+    static constexpr std::size_t Inserts = 2'000;
+#else
+    static constexpr std::size_t Iterations = 5'000'000;      // release
+    static constexpr std::size_t Inserts = 20'000;
+#endif
+
+    // long enough to defeat the small string optimization
+    static const std::string LongString{ "C++ Memory Management - Trivially Relocatable" };
+
+    template <typename TVector>
+    static void pushBackStrings(std::string_view name)
+    {
+        std::println("{} - push_back of std::string", name);
+
+        ScopedTimer watch{};
+
+        TVector vec;
+        for (std::size_t i{}; i != Iterations; ++i) {
+            vec.push_back(LongString);
+        }
+    }
+
+    template <typename TVector>
+    static void pushBackPersons(std::string_view name)
+    {
+        std::println("{} - emplace_back of Person", name);
+
+        ScopedTimer watch{};
+
+        TVector vec;
+        for (std::size_t i{}; i != Iterations; ++i) {
+            vec.emplace_back(LongString, LongString, i);
+        }
+    }
+
+    template <typename TVector>
+    static void pushBackUniquePtrs(std::string_view name)
+    {
+        std::println("{} - push_back of std::unique_ptr<int>", name);
+
+        ScopedTimer watch{};
+
+        TVector vec;
+        for (std::size_t i{}; i != Iterations; ++i) {
+            vec.push_back(std::make_unique<int>(static_cast<int>(i)));
+        }
+    }
+
+    template <typename TVector>
+    static void insertAndEraseStrings(std::string_view name)
+    {
+        std::println("{} - insert / erase at the front of std::string", name);
+
+        ScopedTimer watch{};
+
+        TVector vec;
+        for (std::size_t i{}; i != Inserts; ++i) {
+            vec.insert(vec.begin(), LongString);
+        }
+
+        while (!vec.empty()) {
+            vec.erase(vec.begin());
+        }
+    }
+
+    static void relocatable_vector_benchmark()
+    {
+        pushBackStrings<std::vector<std::string>>("std::vector      ");
+        pushBackStrings<RelocatableVector<std::string>>("RelocatableVector");
+
+        pushBackPersons<std::vector<Person>>("std::vector      ");
+        pushBackPersons<RelocatableVector<Person>>("RelocatableVector");
+
+        pushBackUniquePtrs<std::vector<std::unique_ptr<int>>>("std::vector      ");
+        pushBackUniquePtrs<RelocatableVector<std::unique_ptr<int>>>("RelocatableVector");
+
+        insertAndEraseStrings<std::vector<std::string>>("std::vector      ");
+        insertAndEraseStrings<RelocatableVector<std::string>>("RelocatableVector");
+    }
+}
+
+void memory_management_relocatable_vector()
+{
+    using namespace RelocatableVector_Examples;
+    using namespace RelocatableVector_Benchmark;
+
+    relocatable_vector_01();
+    relocatable_vector_02();
+    relocatable_vector_03();
+    relocatable_vector_04();
+
+    relocatable_vector_benchmark();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
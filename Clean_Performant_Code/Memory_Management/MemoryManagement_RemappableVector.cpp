@@ -0,0 +1,160 @@
+// ===========================================================================
+// MemoryManagement_RemappableVector.cpp // Memory Management
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "RemappableVector.h"
+
+#include <cstddef>
+#include <print>
+#include <vector>
+
+namespace RemappableVector_Examples {
+
+    static void remappable_vector_01()
+    {
+        RemappableVector<int> vec;
+
+        for (int i{}; i != 10; ++i) {
+            vec.push_back(i);
+        }
+
+        std::println("Size: {} - Capacity: {} - Mapped: {}", vec.size(), vec.capacity(), vec.isMapped());
+
+        for (auto value : vec) {
+            std::print("{} ", value);
+        }
+        std::println();
+    }
+
+    static void remappable_vector_02()
+    {
+        RemappableVector<int> vec;
+
+        const int* previous{ vec.data() };
+
+        // watch the buffer moving from the heap into mapped pages
+        for (int i{}; i != 4'000'000; ++i) {
+
+            vec.push_back(i);
+
+            if (vec.data() != previous) {
+                std::println("Size: {:>8} - Capacity: {:>8} - Mapped: {}", vec.size(), vec.capacity(), vec.isMapped());
+                previous = vec.data();
+            }
+        }
+
+        std::println("vec[1'000'000] = {}", vec[1'000'000]);
+    }
+
+    struct Point
+    {
+        int m_x;
+        int m_y;
+    };
+
+    static void remappable_vector_03()
+    {
+        RemappableVector<Point> vec;
+        vec.emplace_back(1, 2);
+
+        // elements of the vector itself as arguments - just at the growth boundary,
+        // where the buffer is reallocated (heap) or remapped (mapped pages)
+        bool correct{ true };
+        std::size_t moves{};
+
+        while (vec.size() != 1'000'000) {
+
+            if (vec.size() == vec.capacity()) {
+
+                const Point* previous{ vec.data() };
+
+                // alternately: a copy of an element - or its members, forwarded by reference
+                const Point& point{ (moves % 2 == 0)
+                    ? vec.emplace_back(vec[0])
+                    : vec.emplace_back(vec[vec.size() - 1].m_x, vec[vec.size() - 1].m_y)
+                };
+
+                correct = correct && point.m_x == 1 && point.m_y == 2;
+                moves += (vec.data() != previous) ? 1 : 0;
+            }
+            else {
+                vec.push_back(vec[0]);
+            }
+        }
+
+        std::println("Size: {} - Mapped: {} - Buffer moved {} times - Self-referencing emplace_back correct: {}",
+            vec.size(), vec.isMapped(), moves, correct);
+    }
+}
+
+namespace RemappableVector_Benchmark {
+
+#ifdef _DEBUG
+    static constexpr std::size_t Iterations = 10'000'000;       // debug
+#else
+    static constexpr std::size_t Iterations = 1'000'000'000;    // release
+#endif
+
+    static void StdVectorPushBack() {
+
+        std::println("std::vector<int> - push_back");
+
+        ScopedTimer watch{};
+
+        std::vector<int> vec;
+        for (std::size_t i{}; i != Iterations; ++i) {
+            vec.push_back(static_cast<int>(i));
+        }
+
+        std::println("Size: {}", vec.size());
+    }
+
+    static void StdVectorReserve() {
+
+        std::println("std::vector<int> - reserve + push_back");
+
+        ScopedTimer watch{};
+
+        std::vector<int> vec;
+        vec.reserve(Iterations);
+        for (std::size_t i{}; i != Iterations; ++i) {
+            vec.push_back(static_cast<int>(i));
+        }
+
+        std::println("Size: {}", vec.size());
+    }
+
+    static void RemappableVectorPushBack() {
+
+        std::println("RemappableVector<int> - push_back");
+
+        ScopedTimer watch{};
+
+        RemappableVector<int> vec;
+        for (std::size_t i{}; i != Iterations; ++i) {
+            vec.push_back(static_cast<int>(i));
+        }
+
+        std::println("Size: {}", vec.size());
+    }
+}
+
+void memory_management_remappable_vector()
+{
+    using namespace RemappableVector_Examples;
+    using namespace RemappableVector_Benchmark;
+
+    remappable_vector_01();
+    remappable_vector_02();
+    remappable_vector_03();
+
+    StdVectorPushBack();
+    StdVectorReserve();
+    RemappableVectorPushBack();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
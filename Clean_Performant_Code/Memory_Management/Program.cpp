@@ -9,6 +9,8 @@ void memory_management_heap();
 void memory_management_alignment_padding();
 void memory_management_placement_new();
 void memory_management_low_level_stl_functions();
+void memory_management_remappable_vector();
+void memory_management_relocatable_vector();
 
 int main()
 {
@@ -19,6 +21,8 @@ int main()
     //memory_management_alignment_padding();
     //memory_management_placement_new();
     //memory_management_low_level_stl_functions();
+    //memory_management_remappable_vector();
+    //memory_management_relocatable_vector();
     
     return 0;
 }
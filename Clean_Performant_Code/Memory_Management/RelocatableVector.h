@@ -0,0 +1,386 @@
+// ===========================================================================
+// RelocatableVector.h // Memory Management
+// ===========================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Relocation {
+
+    // =======================================================================
+    // Type trait 'is_trivially_relocatable':
+    // An object of such a type can be moved to another address with a plain
+    // memcpy - and the source object is *not* destroyed afterwards.
+    // Trivially copyable types qualify automatically, other types opt in.
+
+    template <typename T>
+    struct is_trivially_relocatable
+        : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // std::unique_ptr: just a pointer (and the deleter)
+    template <typename T, typename TDeleter>
+    struct is_trivially_relocatable<std::unique_ptr<T, TDeleter>>
+        : is_trivially_relocatable<TDeleter> {};
+
+    // std::allocator is an empty class
+    template <typename T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+    // std::vector: three pointers - unless the MSVC debug iterators
+    // are enabled (the container proxy points back to the vector)
+#if !defined(_MSVC_STL_VERSION) || (_ITERATOR_DEBUG_LEVEL == 0)
+    template <typename T, typename TAllocator>
+    struct is_trivially_relocatable<std::vector<T, TAllocator>>
+        : is_trivially_relocatable<TAllocator> {};
+#endif
+
+    // std::basic_string: the libstdc++ implementation stores a pointer into
+    // its own SSO buffer, so it is *not* trivially relocatable there
+#if (defined(_MSVC_STL_VERSION) && (_ITERATOR_DEBUG_LEVEL == 0)) || defined(_LIBCPP_VERSION)
+    template <typename TChar, typename TTraits, typename TAllocator>
+    struct is_trivially_relocatable<std::basic_string<TChar, TTraits, TAllocator>>
+        : is_trivially_relocatable<TAllocator> {};
+#endif
+
+    // =======================================================================
+    // relocate [first, last) into uninitialized memory starting at 'dest':
+    // afterwards [first, last) is uninitialized memory
+
+    template <typename T>
+    inline T* uninitialized_relocate(T* first, T* last, T* dest) noexcept(
+        is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+    {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::size_t count{ static_cast<std::size_t>(last - first) };
+            if (count != 0) {
+                std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+            }
+            return dest + count;
+        }
+        else {
+            T* result{ std::uninitialized_move(first, last, dest) };
+            std::destroy(first, last);
+            return result;
+        }
+    }
+
+    // =======================================================================
+    // Vector, that relocates its elements with memcpy / memmove
+    // on reallocation, insert and erase, if possible
+
+    template <typename T>
+    class RelocatableVector
+    {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        // c'tor/d'tor
+        RelocatableVector() = default;
+        ~RelocatableVector();
+
+        // no copy, but move
+        RelocatableVector(const RelocatableVector&) = delete;
+        RelocatableVector& operator=(const RelocatableVector&) = delete;
+        RelocatableVector(RelocatableVector&& other) noexcept;
+        RelocatableVector& operator=(RelocatableVector&& other) noexcept;
+
+        // public interface
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template <typename ... TArgs>
+        T& emplace_back(TArgs&& ... args);
+
+        iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+        template <typename ... TArgs>
+        iterator emplace(const_iterator pos, TArgs&& ... args);
+
+        iterator erase(const_iterator pos);
+
+        void pop_back() noexcept;
+        void clear() noexcept;
+        void reserve(size_type capacity);
+
+        // element access
+        T& operator[](size_type pos) noexcept { return m_data[pos]; }
+        const T& operator[](size_type pos) const noexcept { return m_data[pos]; }
+
+        T* data() noexcept { return m_data; }
+        const T* data() const noexcept { return m_data; }
+
+        iterator begin() noexcept { return m_data; }
+        iterator end() noexcept { return m_data + m_size; }
+        const_iterator begin() const noexcept { return m_data; }
+        const_iterator end() const noexcept { return m_data + m_size; }
+
+        // getter
+        size_type size() const noexcept { return m_size; }
+        size_type capacity() const noexcept { return m_capacity; }
+        bool empty() const noexcept { return m_size == 0; }
+
+    private:
+        // private helper methods
+        void reallocate(size_type newCapacity);
+        void transferTo(T* newData);
+        size_type nextCapacity() const noexcept;
+
+        static T* allocate(size_type count);
+        static void deallocate(T* ptr) noexcept;
+
+        // member data
+        T*         m_data{ nullptr };
+        size_type  m_size{ 0 };
+        size_type  m_capacity{ 0 };
+    };
+
+    // =======================================================================
+    // c'tor/d'tor - move semantics
+
+    template <typename T>
+    inline RelocatableVector<T>::~RelocatableVector()
+    {
+        clear();
+        deallocate(m_data);
+    }
+
+    template <typename T>
+    inline RelocatableVector<T>::RelocatableVector(RelocatableVector&& other) noexcept
+        : m_data{ std::exchange(other.m_data, nullptr) },
+          m_size{ std::exchange(other.m_size, 0) },
+          m_capacity{ std::exchange(other.m_capacity, 0) }
+    {
+    }
+
+    template <typename T>
+    inline RelocatableVector<T>& RelocatableVector<T>::operator=(RelocatableVector&& other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            deallocate(m_data);
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+        }
+
+        return *this;
+    }
+
+    // =======================================================================
+    // public interface
+
+    template <typename T>
+    template <typename ... TArgs>
+    inline T& RelocatableVector<T>::emplace_back(TArgs&& ... args)
+    {
+        if (m_size == m_capacity) {
+
+            // construct the new element first: 'args' might refer to an element of this vector
+            T* newData{ allocate(nextCapacity()) };
+
+            try {
+                std::construct_at(newData + m_size, std::forward<TArgs>(args)...);
+            }
+            catch (...) {
+                deallocate(newData);
+                throw;
+            }
+
+            try {
+                transferTo(newData);
+            }
+            catch (...) {
+                std::destroy_at(newData + m_size);
+                deallocate(newData);
+                throw;
+            }
+
+            deallocate(m_data);
+
+            m_data = newData;
+            m_capacity = nextCapacity();
+        }
+        else {
+            std::construct_at(m_data + m_size, std::forward<TArgs>(args)...);
+        }
+
+        return m_data[m_size++];
+    }
+
+    template <typename T>
+    template <typename ... TArgs>
+    inline typename RelocatableVector<T>::iterator RelocatableVector<T>::emplace(const_iterator pos, TArgs&& ... args)
+    {
+        size_type index{ static_cast<size_type>(pos - m_data) };
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+
+            if (m_size == m_capacity) {
+
+                // construct the new element in the new block first: 'args' might refer
+                // to an element of this vector - then relocate the elements around it
+                T* newData{ allocate(nextCapacity()) };
+
+                try {
+                    std::construct_at(newData + index, std::forward<TArgs>(args)...);
+                }
+                catch (...) {
+                    deallocate(newData);
+                    throw;
+                }
+
+                uninitialized_relocate(m_data, m_data + index, newData);
+                uninitialized_relocate(m_data + index, m_data + m_size, newData + index + 1);
+                deallocate(m_data);
+
+                m_data = newData;
+                m_capacity = nextCapacity();
+            }
+            else {
+                // build the new element aside, so that an exception leaves the vector untouched
+                alignas(T) std::byte buffer[sizeof(T)];
+                std::construct_at(reinterpret_cast<T*>(buffer), std::forward<TArgs>(args)...);
+
+                // open a gap with a single memmove and relocate the new element into it
+                T* gap{ m_data + index };
+                uninitialized_relocate(gap, m_data + m_size, gap + 1);
+                std::memcpy(static_cast<void*>(gap), buffer, sizeof(T));
+            }
+
+            ++m_size;
+        }
+        else {
+            T value(std::forward<TArgs>(args)...);
+
+            if (index == m_size) {
+                emplace_back(std::move(value));
+            }
+            else {
+                // element-wise: move the last element into the new slot, shift the others by one
+                emplace_back(std::move(m_data[m_size - 1]));
+                std::move_backward(m_data + index, m_data + m_size - 2, m_data + m_size - 1);
+                m_data[index] = std::move(value);
+            }
+        }
+
+        return m_data + index;
+    }
+
+    template <typename T>
+    inline typename RelocatableVector<T>::iterator RelocatableVector<T>::erase(const_iterator pos)
+    {
+        size_type index{ static_cast<size_type>(pos - m_data) };
+        T* ptr{ m_data + index };
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // close the gap with a single memmove
+            std::destroy_at(ptr);
+            uninitialized_relocate(ptr + 1, m_data + m_size, ptr);
+        }
+        else {
+            std::move(ptr + 1, m_data + m_size, ptr);
+            std::destroy_at(m_data + m_size - 1);
+        }
+
+        --m_size;
+        return ptr;
+    }
+
+    template <typename T>
+    inline void RelocatableVector<T>::pop_back() noexcept
+    {
+        --m_size;
+        std::destroy_at(m_data + m_size);
+    }
+
+    template <typename T>
+    inline void RelocatableVector<T>::clear() noexcept
+    {
+        std::destroy(m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+    template <typename T>
+    inline void RelocatableVector<T>::reserve(size_type capacity)
+    {
+        if (capacity > m_capacity) {
+            reallocate(capacity);
+        }
+    }
+
+    // =======================================================================
+    // private helper methods
+
+    template <typename T>
+    inline void RelocatableVector<T>::reallocate(size_type newCapacity)
+    {
+        T* newData{ allocate(newCapacity) };
+
+        try {
+            transferTo(newData);
+        }
+        catch (...) {
+            deallocate(newData);
+            throw;
+        }
+
+        deallocate(m_data);
+
+        m_data = newData;
+        m_capacity = newCapacity;
+    }
+
+    template <typename T>
+    inline void RelocatableVector<T>::transferTo(T* newData)
+    {
+        if constexpr (is_trivially_relocatable_v<T> ||
+            std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+        {
+            uninitialized_relocate(m_data, m_data + m_size, newData);
+        }
+        else {
+            // strong exception guarantee: copy first, then destroy the originals
+            std::uninitialized_copy(m_data, m_data + m_size, newData);
+            std::destroy(m_data, m_data + m_size);
+        }
+    }
+
+    template <typename T>
+    inline typename RelocatableVector<T>::size_type RelocatableVector<T>::nextCapacity() const noexcept
+    {
+        return (m_capacity == 0) ? 1 : 2 * m_capacity;
+    }
+
+    template <typename T>
+    inline T* RelocatableVector<T>::allocate(size_type count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ alignof(T) }));
+    }
+
+    template <typename T>
+    inline void RelocatableVector<T>::deallocate(T* ptr) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t{ alignof(T) });
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,390 @@
+// ===========================================================================
+// RemappableVector.h // Memory Management
+// ===========================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Vector-like container for trivially copyable elements.
+// Small buffers are managed with std::malloc / std::realloc,
+// buffers above 'MapThreshold' bytes are taken directly from
+// the virtual memory manager of the operating system:
+//
+//  * Linux:   mmap - and growth with mremap(MREMAP_MAYMOVE),
+//             only page table entries are moved, no elements are copied.
+//  * Windows: a large address range is reserved with VirtualAlloc
+//             and pages are committed on demand - the buffer never moves.
+//  * Other:   mmap - growth falls back to mmap / memcpy / munmap.
+
+template <typename T>
+class RemappableVector
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+        "RemappableVector requires trivially copyable elements!");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_type MapThreshold{ 1024 * 1024 };  // bytes
+
+    // c'tor/d'tor
+    RemappableVector() = default;
+    ~RemappableVector();
+
+    // no copy, but move
+    RemappableVector(const RemappableVector&) = delete;
+    RemappableVector& operator=(const RemappableVector&) = delete;
+    RemappableVector(RemappableVector&& other) noexcept;
+    RemappableVector& operator=(RemappableVector&& other) noexcept;
+
+    // public interface
+    void push_back(const T& value);
+
+    template <typename ... TArgs>
+    T& emplace_back(TArgs&& ... args);
+
+    void pop_back() noexcept { --m_size; }
+    void clear() noexcept { m_size = 0; }
+    void reserve(size_type capacity);
+    void resize(size_type size);
+
+    // element access
+    T& operator[](size_type pos) noexcept { return m_data[pos]; }
+    const T& operator[](size_type pos) const noexcept { return m_data[pos]; }
+
+    T* data() noexcept { return m_data; }
+    const T* data() const noexcept { return m_data; }
+
+    iterator begin() noexcept { return m_data; }
+    iterator end() noexcept { return m_data + m_size; }
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+
+    // getter
+    size_type size() const noexcept { return m_size; }
+    size_type capacity() const noexcept { return m_capacity; }
+    bool empty() const noexcept { return m_size == 0; }
+    bool isMapped() const noexcept { return m_mapped; }
+
+private:
+    // private helper methods
+    void grow(size_type minCapacity);
+    void release() noexcept;
+
+    static size_type pageSize() noexcept;
+    static size_type roundToPages(size_type bytes) noexcept;
+
+    static void* mapPages(size_type bytes, size_type& reserved);
+    static void* remapPages(void* ptr, size_type oldBytes, size_type newBytes, size_type& reserved);
+    static void  unmapPages(void* ptr, size_type bytes, size_type reserved) noexcept;
+
+    // member data
+    T*         m_data{ nullptr };
+    size_type  m_size{ 0 };
+    size_type  m_capacity{ 0 };
+    size_type  m_reserved{ 0 };    // reserved address space in bytes (mapped mode only)
+    bool       m_mapped{ false };
+};
+
+// ===========================================================================
+// c'tor/d'tor - move semantics
+
+template <typename T>
+inline RemappableVector<T>::~RemappableVector()
+{
+    release();
+}
+
+template <typename T>
+inline RemappableVector<T>::RemappableVector(RemappableVector&& other) noexcept
+    : m_data{ std::exchange(other.m_data, nullptr) },
+      m_size{ std::exchange(other.m_size, 0) },
+      m_capacity{ std::exchange(other.m_capacity, 0) },
+      m_reserved{ std::exchange(other.m_reserved, 0) },
+      m_mapped{ std::exchange(other.m_mapped, false) }
+{
+}
+
+template <typename T>
+inline RemappableVector<T>& RemappableVector<T>::operator=(RemappableVector&& other) noexcept
+{
+    if (this != &other) {
+        release();
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_reserved = std::exchange(other.m_reserved, 0);
+        m_mapped = std::exchange(other.m_mapped, false);
+    }
+
+    return *this;
+}
+
+// ===========================================================================
+// public interface
+
+template <typename T>
+inline void RemappableVector<T>::push_back(const T& value)
+{
+    if (m_size == m_capacity) {
+        // 'value' might be an element of this vector: copy it first
+        T copy{ value };
+        grow(m_size + 1);
+        m_data[m_size++] = copy;
+    }
+    else {
+        m_data[m_size++] = value;
+    }
+}
+
+template <typename T>
+template <typename ... TArgs>
+inline T& RemappableVector<T>::emplace_back(TArgs&& ... args)
+{
+    if (m_size == m_capacity) {
+        // 'args' might refer to an element of this vector: construct the new one first
+        T value{ std::forward<TArgs>(args)... };
+        grow(m_size + 1);
+        T* ptr{ ::new (m_data + m_size) T{ value } };
+        ++m_size;
+        return *ptr;
+    }
+
+    T* ptr{ ::new (m_data + m_size) T{ std::forward<TArgs>(args)... } };
+    ++m_size;
+    return *ptr;
+}
+
+template <typename T>
+inline void RemappableVector<T>::reserve(size_type capacity)
+{
+    if (capacity > m_capacity) {
+        grow(capacity);
+    }
+}
+
+template <typename T>
+inline void RemappableVector<T>::resize(size_type size)
+{
+    reserve(size);
+
+    if (size > m_size) {
+        std::memset(static_cast<void*>(m_data + m_size), 0, (size - m_size) * sizeof(T));
+    }
+
+    m_size = size;
+}
+
+// ===========================================================================
+// private helper methods
+
+template <typename T>
+inline void RemappableVector<T>::grow(size_type minCapacity)
+{
+    size_type newCapacity{ std::max(minCapacity, 2 * m_capacity) };
+    newCapacity = std::max(newCapacity, size_type{ 16 });
+
+    size_type newBytes{ newCapacity * sizeof(T) };
+
+    if (newBytes < MapThreshold) {
+
+        // small buffer: the C runtime heap is good enough
+        void* ptr{ std::realloc(m_data, newBytes) };
+        if (ptr == nullptr) {
+            throw std::bad_alloc{};
+        }
+
+        m_data = static_cast<T*>(ptr);
+    }
+    else {
+
+        newBytes = roundToPages(newBytes);
+
+        if (m_mapped) {
+            m_data = static_cast<T*>(remapPages(m_data, m_capacity * sizeof(T), newBytes, m_reserved));
+        }
+        else {
+            // leaving the heap: one (small) copy of at most 'MapThreshold' bytes
+            void* ptr{ mapPages(newBytes, m_reserved) };
+
+            if (m_data != nullptr) {
+                std::memcpy(ptr, m_data, m_size * sizeof(T));
+                std::free(m_data);
+            }
+
+            m_data = static_cast<T*>(ptr);
+            m_mapped = true;
+        }
+
+        newCapacity = newBytes / sizeof(T);
+    }
+
+    m_capacity = newCapacity;
+}
+
+template <typename T>
+inline void RemappableVector<T>::release() noexcept
+{
+    if (m_data == nullptr) {
+        return;
+    }
+
+    if (m_mapped) {
+        unmapPages(m_data, m_capacity * sizeof(T), m_reserved);
+    }
+    else {
+        std::free(m_data);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_capacity = 0;
+    m_reserved = 0;
+    m_mapped = false;
+}
+
+template <typename T>
+inline typename RemappableVector<T>::size_type RemappableVector<T>::roundToPages(size_type bytes) noexcept
+{
+    const size_type page{ pageSize() };
+    return (bytes + page - 1) / page * page;
+}
+
+#if defined(_WIN32)
+
+template <typename T>
+inline typename RemappableVector<T>::size_type RemappableVector<T>::pageSize() noexcept
+{
+    static const size_type page = [] () {
+        SYSTEM_INFO info{};
+        ::GetSystemInfo(&info);
+        return static_cast<size_type>(info.dwPageSize);
+    } ();
+
+    return page;
+}
+
+// reserve plenty of address space, so that the buffer never has to move
+static constexpr std::size_t RemappableVectorReservation{
+    sizeof(void*) == 8 ? (std::size_t{ 1 } << 36) : (std::size_t{ 1 } << 28)
+};
+
+template <typename T>
+inline void* RemappableVector<T>::mapPages(size_type bytes, size_type& reserved)
+{
+    reserved = roundToPages(std::max(bytes, RemappableVectorReservation));
+
+    void* ptr{ ::VirtualAlloc(nullptr, reserved, MEM_RESERVE, PAGE_NOACCESS) };
+    if (ptr == nullptr || ::VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+        if (ptr != nullptr) {
+            ::VirtualFree(ptr, 0, MEM_RELEASE);
+        }
+        throw std::bad_alloc{};
+    }
+
+    return ptr;
+}
+
+template <typename T>
+inline void* RemappableVector<T>::remapPages(void* ptr, size_type oldBytes, size_type newBytes, size_type& reserved)
+{
+    if (newBytes <= reserved) {
+        // commit the additional pages in place
+        if (::VirtualAlloc(ptr, newBytes, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+            throw std::bad_alloc{};
+        }
+        return ptr;
+    }
+
+    // reservation exhausted: move to a larger reservation
+    size_type newReserved{};
+    void* newPtr{ mapPages(newBytes, newReserved) };
+    std::memcpy(newPtr, ptr, oldBytes);
+    ::VirtualFree(ptr, 0, MEM_RELEASE);
+
+    reserved = newReserved;
+    return newPtr;
+}
+
+template <typename T>
+inline void RemappableVector<T>::unmapPages(void* ptr, size_type, size_type) noexcept
+{
+    ::VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+#else
+
+template <typename T>
+inline typename RemappableVector<T>::size_type RemappableVector<T>::pageSize() noexcept
+{
+    static const size_type page{ static_cast<size_type>(::sysconf(_SC_PAGESIZE)) };
+    return page;
+}
+
+template <typename T>
+inline void* RemappableVector<T>::mapPages(size_type bytes, size_type& reserved)
+{
+    void* ptr{ ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+    if (ptr == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+
+    reserved = bytes;
+    return ptr;
+}
+
+template <typename T>
+inline void* RemappableVector<T>::remapPages(void* ptr, [[maybe_unused]] size_type oldBytes, size_type newBytes, size_type& reserved)
+{
+#if defined(__linux__)
+    // the kernel moves page table entries - no element is copied
+    void* newPtr{ ::mremap(ptr, reserved, newBytes, MREMAP_MAYMOVE) };
+    if (newPtr == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+#else
+    size_type newReserved{};
+    void* newPtr{ mapPages(newBytes, newReserved) };
+    std::memcpy(newPtr, ptr, oldBytes);
+    ::munmap(ptr, reserved);
+#endif
+
+    reserved = newBytes;
+    return newPtr;
+}
+
+template <typename T>
+inline void RemappableVector<T>::unmapPages(void* ptr, size_type, size_type reserved) noexcept
+{
+    ::munmap(ptr, reserved);
+}
+
+#endif
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,828 @@
+// ===========================================================================
+// Allocator_Benchmark_Suite.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+// All allocators of this project run through the same set of workloads:
+//
+//   LIFO, FIFO, Random    - allocate 'Count' blocks, free them in stack order,
+//                           in queue order or in a shuffled order
+//   Producer/Consumer     - one thread allocates, another thread frees
+//   Sized-Mixed           - block sizes between 8 and 512 bytes, random order
+//   Churn                 - long-lived objects plus many short-lived objects
+//
+// Reported are throughput (ops/sec), p99 latency of a single allocate or
+// deallocate call, peak RSS growth and fragmentation, i.e. the part of the
+// RSS growth which is not occupied by live blocks.
+
+#include "CustomAllocator.h"
+#include "FixedBlockMemoryManager.h"
+#include "ObjectPool_DynamicSize.h"
+#include "ObjectPool_FixedSize.h"
+#include "ObjectPool_ThreadSafe.h"
+#include "PMR_FixedArenaResource.h"
+#include "PMR_TrackingResource.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <numeric>
+#include <print>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#endif
+
+namespace AllocatorBenchmarkSuite {
+
+#ifdef _DEBUG
+    static constexpr std::size_t Count = 10'000;          // debug
+#else
+    static constexpr std::size_t Count = 100'000;         // release
+#endif
+
+    static constexpr std::size_t BlockSize = 32;
+    static constexpr std::size_t MinMixedSize = 8;
+    static constexpr std::size_t MaxMixedSize = 512;
+
+    // FixedArenaResource never releases memory - the arena must hold every allocation of a run
+    static constexpr std::size_t ArenaSize = (MaxMixedSize + MaxMixedSize / 4) * Count;
+
+    struct Block
+    {
+        std::byte m_data[BlockSize];
+    };
+
+    // =======================================================================
+    // process memory
+
+    static std::size_t currentRSS()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<std::size_t>(counters.WorkingSetSize);
+        }
+        return 0;
+#else
+        std::size_t pages{}, resident{};
+        std::ifstream statm{ "/proc/self/statm" };
+        if (statm >> pages >> resident) {
+            return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        }
+        return 0;
+#endif
+    }
+
+    // give memory freed by a previous run back to the operating system,
+    // otherwise the next run would (partially) reuse it "for free"
+    static void trimHeap()
+    {
+#if defined(_WIN32)
+        ::HeapCompact(::GetProcessHeap(), 0);
+#elif defined(__GLIBC__)
+        ::malloc_trim(0);
+#endif
+    }
+
+    // =======================================================================
+    // adapters: a common interface for all allocators
+
+    static void* address(void* handle) { return handle; }
+
+    template <typename T, typename TDeleter>
+    static void* address(const std::unique_ptr<T, TDeleter>& handle) { return handle.get(); }
+
+    struct StdAllocatorAdapter
+    {
+        static constexpr std::string_view Name{ "std::allocator" };
+        static constexpr bool FixedSize{ false };
+        static constexpr bool ThreadSafe{ true };
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t bytes) { return m_allocator.allocate(bytes); }
+        void deallocate(Handle& handle, std::size_t bytes) { m_allocator.deallocate(static_cast<std::byte*>(handle), bytes); }
+
+        std::allocator<std::byte> m_allocator;
+    };
+
+    struct CustomAllocatorAdapter
+    {
+        static constexpr std::string_view Name{ "CustomAllocator" };
+        static constexpr bool FixedSize{ false };
+        static constexpr bool ThreadSafe{ true };
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t bytes) { return m_allocator.allocate(bytes); }
+        void deallocate(Handle& handle, std::size_t bytes) { m_allocator.deallocate(static_cast<std::byte*>(handle), bytes); }
+
+        CustomAllocator<std::byte> m_allocator;
+    };
+
+    // FixedBlockAllocator<T> is bound to a global 200 byte arena,
+    // so its engine - FixedBlockMemoryManager - is measured directly
+    struct FixedBlockMemoryManagerAdapter
+    {
+        static constexpr std::string_view Name{ "FixedBlockMemoryManager" };
+        static constexpr bool FixedSize{ true };
+        static constexpr bool ThreadSafe{ false };
+
+        using Handle = void*;
+
+        FixedBlockMemoryManagerAdapter() : m_manager{ manager() } { m_manager.clear(); }
+
+        Handle allocate(std::size_t bytes) { return m_manager.allocate(bytes); }
+        void deallocate(Handle& handle, std::size_t) { m_manager.deallocate(handle); }
+
+        // the arena is a static array, the c'tors print some tracing output: create it once
+        // (after the first run the arena stays resident - there is no RSS growth to report)
+        static FixedBlockMemoryManager<FixedArenaController>& manager()
+        {
+            alignas(std::max_align_t) static char arena[Count * BlockSize];
+            static FixedBlockMemoryManager<FixedArenaController> manager{ arena };
+            return manager;
+        }
+
+        FixedBlockMemoryManager<FixedArenaController>& m_manager;
+    };
+
+    template <typename TResource>
+    struct MemoryResourceAdapter
+    {
+        static constexpr bool FixedSize{ false };
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t bytes) { return m_resource.allocate(bytes, alignof(std::max_align_t)); }
+        void deallocate(Handle& handle, std::size_t bytes) { m_resource.deallocate(handle, bytes, alignof(std::max_align_t)); }
+
+        TResource m_resource;
+    };
+
+    struct UnsynchronizedPoolAdapter : MemoryResourceAdapter<std::pmr::unsynchronized_pool_resource>
+    {
+        static constexpr std::string_view Name{ "pmr::unsynchronized_pool" };
+        static constexpr bool ThreadSafe{ false };
+    };
+
+    struct SynchronizedPoolAdapter : MemoryResourceAdapter<std::pmr::synchronized_pool_resource>
+    {
+        static constexpr std::string_view Name{ "pmr::synchronized_pool" };
+        static constexpr bool ThreadSafe{ true };
+    };
+
+    struct MonotonicBufferAdapter : MemoryResourceAdapter<std::pmr::monotonic_buffer_resource>
+    {
+        static constexpr std::string_view Name{ "pmr::monotonic_buffer" };
+        static constexpr bool ThreadSafe{ false };
+    };
+
+    struct FixedArenaResourceAdapter
+    {
+        static constexpr std::string_view Name{ "FixedArenaResource" };
+        static constexpr bool FixedSize{ false };
+        static constexpr bool ThreadSafe{ false };
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t bytes) { return m_resource.allocate(bytes, alignof(std::max_align_t)); }
+        void deallocate(Handle& handle, std::size_t bytes) { m_resource.deallocate(handle, bytes, alignof(std::max_align_t)); }
+
+        // the pages of the arena are not touched before they are used
+        std::unique_ptr<std::byte[]> m_buffer{ new std::byte[ArenaSize] };
+        FixedArenaResource           m_resource{ m_buffer.get(), ArenaSize };
+    };
+
+    struct TrackingResourceAdapter
+    {
+        static constexpr std::string_view Name{ "TrackingResource" };
+        static constexpr bool FixedSize{ false };
+        static constexpr bool ThreadSafe{ false };    // counters are not atomic
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t bytes) { return m_resource.allocate(bytes, alignof(std::max_align_t)); }
+        void deallocate(Handle& handle, std::size_t bytes) { m_resource.deallocate(handle, bytes, alignof(std::max_align_t)); }
+
+        TrackingResource m_resource{ std::pmr::new_delete_resource() };
+    };
+
+    struct FixedSizeObjectPoolAdapter
+    {
+        static constexpr std::string_view Name{ "FixedSizeObjectPool" };
+        static constexpr bool FixedSize{ true };
+        static constexpr bool ThreadSafe{ false };
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t) { return m_pool.allocate(); }
+        void deallocate(Handle& handle, std::size_t) { m_pool.deallocate(static_cast<Block*>(handle)); }
+
+        FixedSizeObjectPool::ObjectPool<Block, Count> m_pool;
+    };
+
+    struct DynamicSizeObjectPoolAdapter
+    {
+        static constexpr std::string_view Name{ "DynamicSizeObjectPool" };
+        static constexpr bool FixedSize{ true };
+        static constexpr bool ThreadSafe{ false };
+
+        using Handle = DynamicSizeObjectPool::PooledPtr<Block>;
+
+        Handle allocate(std::size_t) { return m_pool.acquireObject(); }
+        void deallocate(Handle& handle, std::size_t) { handle.reset(); }
+
+        DynamicSizeObjectPool::ObjectPool<Block> m_pool;
+    };
+
+    struct ThreadSafeObjectPoolAdapter
+    {
+        static constexpr std::string_view Name{ "FixedSizeObjectPoolThreadSafe" };
+        static constexpr bool FixedSize{ true };
+        static constexpr bool ThreadSafe{ true };
+
+        using Handle = void*;
+
+        Handle allocate(std::size_t) { return m_pool.allocate(); }
+        void deallocate(Handle& handle, std::size_t) { m_pool.deallocate(static_cast<Block*>(handle)); }
+
+        FixedSizeObjectPoolThreadSafe::ObjectPool<Block, Count> m_pool;
+    };
+
+    // =======================================================================
+    // probes: either just run an operation or measure its latency
+
+    struct ThroughputProbe
+    {
+        template <typename TOperation>
+        void measure(TOperation&& operation) { operation(); }
+
+        // 'bookkeepingBytes': memory of the workload itself, e.g. the handle vectors
+        void peak(std::size_t liveBytes, std::size_t bookkeepingBytes)
+        {
+            m_liveBytes = liveBytes;
+            m_bookkeepingBytes = bookkeepingBytes;
+            m_peakRSS = currentRSS();
+        }
+
+        void merge(const ThroughputProbe&) {}
+
+        std::size_t m_liveBytes{};
+        std::size_t m_bookkeepingBytes{};
+        std::size_t m_peakRSS{};
+    };
+
+    struct LatencyProbe
+    {
+        LatencyProbe() { m_samples.reserve(4 * Count); }
+
+        template <typename TOperation>
+        void measure(TOperation&& operation)
+        {
+            const auto begin{ std::chrono::steady_clock::now() };
+            operation();
+            const auto end{ std::chrono::steady_clock::now() };
+            m_samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+
+        void peak(std::size_t, std::size_t) {}
+
+        void merge(const LatencyProbe& other)
+        {
+            m_samples.insert(m_samples.end(), other.m_samples.begin(), other.m_samples.end());
+        }
+
+        double percentile(double p)
+        {
+            if (m_samples.empty()) {
+                return 0.0;
+            }
+
+            auto nth{ m_samples.begin() + static_cast<std::ptrdiff_t>(p * (m_samples.size() - 1)) };
+            std::nth_element(m_samples.begin(), nth, m_samples.end());
+            return static_cast<double>(*nth);
+        }
+
+        std::vector<long long> m_samples;
+    };
+
+    // =======================================================================
+    // input data of the workloads - computed once, outside of any measurement
+
+    static const std::vector<std::size_t>& shuffledIndices()
+    {
+        static const std::vector<std::size_t> indices = [] () {
+            std::vector<std::size_t> result(Count);
+            std::iota(result.begin(), result.end(), std::size_t{});
+            std::shuffle(result.begin(), result.end(), std::mt19937{ 1 });
+            return result;
+        } ();
+
+        return indices;
+    }
+
+    static const std::vector<std::size_t>& mixedSizes()
+    {
+        static const std::vector<std::size_t> sizes = [] () {
+            std::mt19937 generator{ 2 };
+            std::uniform_int_distribution<std::size_t> distribution{ MinMixedSize / 8, MaxMixedSize / 8 };
+
+            std::vector<std::size_t> result(Count);
+            for (auto& size : result) {
+                size = 8 * distribution(generator);
+            }
+            return result;
+        } ();
+
+        return sizes;
+    }
+
+    static constexpr std::size_t LongLived = Count / 2;
+    static constexpr std::size_t ShortLivedSlots = Count / 4;
+    static constexpr std::size_t ChurnRounds = 2 * Count;
+
+    static const std::vector<std::size_t>& churnSlots()
+    {
+        static const std::vector<std::size_t> slots = [] () {
+            std::mt19937 generator{ 3 };
+            std::uniform_int_distribution<std::size_t> distribution{ 0, ShortLivedSlots - 1 };
+
+            std::vector<std::size_t> result(ChurnRounds);
+            for (auto& slot : result) {
+                slot = distribution(generator);
+            }
+            return result;
+        } ();
+
+        return slots;
+    }
+
+    // =======================================================================
+    // workloads - each one returns the number of allocate / deallocate calls
+
+    enum class Workload { Lifo, Fifo, Random, ProducerConsumer, SizedMixed, Churn };
+
+    static constexpr std::array<Workload, 6> Workloads{
+        Workload::Lifo, Workload::Fifo, Workload::Random,
+        Workload::ProducerConsumer, Workload::SizedMixed, Workload::Churn
+    };
+
+    static constexpr std::array<std::string_view, 6> WorkloadNames{
+        "LIFO", "FIFO", "Random", "Prod/Cons", "Mixed", "Churn"
+    };
+
+    // write to each block, otherwise the pages would never become resident
+    template <typename THandle>
+    static void touch(const THandle& handle, std::size_t bytes)
+    {
+        std::memset(address(handle), 0xAB, bytes);
+    }
+
+    template <typename TAdapter, typename TProbe, typename TOrder>
+    static std::size_t allocateAndFree(TAdapter& adapter, TProbe& probe, TOrder order)
+    {
+        std::vector<typename TAdapter::Handle> handles(Count);
+
+        for (auto& handle : handles) {
+            probe.measure([&] () { handle = adapter.allocate(BlockSize); });
+            touch(handle, BlockSize);
+        }
+
+        probe.peak(Count * BlockSize, Count * sizeof(typename TAdapter::Handle));
+
+        for (std::size_t i{}; i != Count; ++i) {
+            auto& handle{ handles[order(i)] };
+            probe.measure([&] () { adapter.deallocate(handle, BlockSize); });
+        }
+
+        return 2 * Count;
+    }
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t lifo(TAdapter& adapter, TProbe& probe)
+    {
+        return allocateAndFree(adapter, probe, [] (std::size_t i) { return Count - 1 - i; });
+    }
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t fifo(TAdapter& adapter, TProbe& probe)
+    {
+        return allocateAndFree(adapter, probe, [] (std::size_t i) { return i; });
+    }
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t random(TAdapter& adapter, TProbe& probe)
+    {
+        const auto& indices{ shuffledIndices() };
+        return allocateAndFree(adapter, probe, [&] (std::size_t i) { return indices[i]; });
+    }
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t sizedMixed(TAdapter& adapter, TProbe& probe)
+    {
+        const auto& sizes{ mixedSizes() };
+        const auto& indices{ shuffledIndices() };
+
+        std::vector<typename TAdapter::Handle> handles(Count);
+
+        for (std::size_t i{}; i != Count; ++i) {
+            probe.measure([&] () { handles[i] = adapter.allocate(sizes[i]); });
+            touch(handles[i], sizes[i]);
+        }
+
+        probe.peak(std::accumulate(sizes.begin(), sizes.end(), std::size_t{}), Count * sizeof(typename TAdapter::Handle));
+
+        for (auto index : indices) {
+            probe.measure([&] () { adapter.deallocate(handles[index], sizes[index]); });
+        }
+
+        return 2 * Count;
+    }
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t churn(TAdapter& adapter, TProbe& probe)
+    {
+        std::size_t ops{};
+
+        std::vector<typename TAdapter::Handle> longLived(LongLived);
+        std::vector<typename TAdapter::Handle> shortLived(ShortLivedSlots);
+
+        for (auto& handle : longLived) {
+            probe.measure([&] () { handle = adapter.allocate(BlockSize); });
+            touch(handle, BlockSize);
+            ++ops;
+        }
+
+        // short-lived objects: each round replaces the object of a random slot
+        for (auto slot : churnSlots()) {
+
+            auto& handle{ shortLived[slot] };
+
+            if (handle) {
+                probe.measure([&] () { adapter.deallocate(handle, BlockSize); });
+                ++ops;
+            }
+
+            probe.measure([&] () { handle = adapter.allocate(BlockSize); });
+            touch(handle, BlockSize);
+            ++ops;
+        }
+
+        const auto occupied{ static_cast<std::size_t>(
+            std::count_if(shortLived.begin(), shortLived.end(), [] (const auto& handle) { return static_cast<bool>(handle); })) };
+
+        probe.peak((LongLived + occupied) * BlockSize, (LongLived + ShortLivedSlots) * sizeof(typename TAdapter::Handle));
+
+        for (auto& handle : shortLived) {
+            if (handle) {
+                probe.measure([&] () { adapter.deallocate(handle, BlockSize); });
+                ++ops;
+            }
+        }
+
+        for (auto& handle : longLived) {
+            probe.measure([&] () { adapter.deallocate(handle, BlockSize); });
+            ++ops;
+        }
+
+        return ops;
+    }
+
+    // single producer / single consumer ring buffer of block addresses
+    class SpscQueue
+    {
+    public:
+        void push(void* ptr)
+        {
+            const auto tail{ m_tail.load(std::memory_order_relaxed) };
+            while (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+                std::this_thread::yield();
+            }
+
+            m_buffer[tail % Capacity] = ptr;
+            m_tail.store(tail + 1, std::memory_order_release);
+        }
+
+        void* pop()
+        {
+            const auto head{ m_head.load(std::memory_order_relaxed) };
+            while (m_tail.load(std::memory_order_acquire) == head) {
+                std::this_thread::yield();
+            }
+
+            void* ptr{ m_buffer[head % Capacity] };
+            m_head.store(head + 1, std::memory_order_release);
+            return ptr;
+        }
+
+        // number of blocks in the queue - exact for the producer, which alone increases it
+        std::size_t size() const
+        {
+            return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire);
+        }
+
+        static constexpr std::size_t Capacity{ 1024 };
+
+    private:
+
+        std::array<void*, Capacity>           m_buffer{};
+        alignas(64) std::atomic<std::size_t>  m_head{};
+        alignas(64) std::atomic<std::size_t>  m_tail{};
+    };
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t producerConsumer(TAdapter& adapter, TProbe& probe)
+    {
+        SpscQueue queue;
+        TProbe consumerProbe;
+
+        std::thread consumer{ [&] () {
+            for (std::size_t i{}; i != Count; ++i) {
+                void* ptr{ queue.pop() };
+                consumerProbe.measure([&] () { adapter.deallocate(ptr, BlockSize); });
+            }
+        } };
+
+        // the memory consumption is sampled, when the most blocks are in flight:
+        // when the queue is full for the first time - or else at the end, with the most blocks seen
+        std::size_t maxInFlight{};
+        bool sampled{};
+
+        for (std::size_t i{}; i != Count; ++i) {
+            void* ptr{};
+            probe.measure([&] () { ptr = adapter.allocate(BlockSize); });
+            touch(ptr, BlockSize);
+            queue.push(ptr);
+
+            if (const std::size_t inFlight{ queue.size() }; inFlight > maxInFlight) {
+                maxInFlight = inFlight;
+                if (inFlight == SpscQueue::Capacity && !sampled) {
+                    probe.peak(maxInFlight * BlockSize, sizeof(SpscQueue));
+                    sampled = true;
+                }
+            }
+        }
+
+        if (!sampled) {
+            probe.peak(maxInFlight * BlockSize, sizeof(SpscQueue));
+        }
+
+        consumer.join();
+        probe.merge(consumerProbe);
+
+        return 2 * Count;
+    }
+
+    template <typename TAdapter>
+    static constexpr bool supports(Workload workload)
+    {
+        switch (workload)
+        {
+        case Workload::ProducerConsumer:
+            return TAdapter::ThreadSafe && std::is_same_v<typename TAdapter::Handle, void*>;
+        case Workload::SizedMixed:
+            return !TAdapter::FixedSize;
+        default:
+            return true;
+        }
+    }
+
+    template <typename TAdapter, typename TProbe>
+    static std::size_t runWorkload(Workload workload, TAdapter& adapter, TProbe& probe)
+    {
+        switch (workload)
+        {
+        case Workload::Lifo:
+            return lifo(adapter, probe);
+        case Workload::Fifo:
+            return fifo(adapter, probe);
+        case Workload::Random:
+            return random(adapter, probe);
+        case Workload::ProducerConsumer:
+            if constexpr (TAdapter::ThreadSafe && std::is_same_v<typename TAdapter::Handle, void*>) {
+                return producerConsumer(adapter, probe);
+            }
+            break;
+        case Workload::SizedMixed:
+            if constexpr (!TAdapter::FixedSize) {
+                return sizedMixed(adapter, probe);
+            }
+            break;
+        case Workload::Churn:
+            return churn(adapter, probe);
+        }
+
+        return 0;
+    }
+
+    // =======================================================================
+    // measurement
+
+    struct Result
+    {
+        bool         m_supported{ false };
+        bool         m_failed{ false };
+        double       m_opsPerSec{};
+        double       m_p99{};             // nanoseconds
+        long long    m_peakRSS{ -1 };     // bytes, -1: not available
+        double       m_fragmentation{ -1.0 };
+    };
+
+    struct Row
+    {
+        std::string_view                         m_name;
+        std::array<Result, Workloads.size()>     m_results;
+    };
+
+    template <typename TAdapter>
+    static Result measure(Workload workload)
+    {
+        Result result{};
+
+        if (!supports<TAdapter>(workload)) {
+            return result;
+        }
+
+        result.m_supported = true;
+
+        try {
+            // first pass: throughput and memory consumption
+            {
+                trimHeap();
+                const auto baseline{ static_cast<long long>(currentRSS()) };
+
+                ThroughputProbe probe{};
+                auto adapter{ std::make_unique<TAdapter>() };
+
+                const auto begin{ std::chrono::steady_clock::now() };
+                const auto ops{ runWorkload(workload, *adapter, probe) };
+                const auto end{ std::chrono::steady_clock::now() };
+
+                const std::chrono::duration<double> seconds{ end - begin };
+                result.m_opsPerSec = ops / seconds.count();
+
+                if (probe.m_peakRSS != 0) {
+                    result.m_peakRSS = static_cast<long long>(probe.m_peakRSS - probe.m_bookkeepingBytes) - baseline;
+                    if (result.m_peakRSS > 0) {
+                        result.m_fragmentation = 1.0 - static_cast<double>(probe.m_liveBytes) / result.m_peakRSS;
+                    }
+                }
+            }
+
+            // second pass: latency of each single call
+            {
+                LatencyProbe probe{};
+                auto adapter{ std::make_unique<TAdapter>() };
+
+                runWorkload(workload, *adapter, probe);
+                result.m_p99 = probe.percentile(0.99);
+            }
+        }
+        catch (const std::bad_alloc&) {
+            result.m_failed = true;
+        }
+
+        return result;
+    }
+
+    template <typename TAdapter>
+    static Row measureAll()
+    {
+        std::println("Running {} ...", TAdapter::Name);
+
+        Row row{ TAdapter::Name, {} };
+        for (std::size_t i{}; i != Workloads.size(); ++i) {
+            row.m_results[i] = measure<TAdapter>(Workloads[i]);
+        }
+        return row;
+    }
+
+    // =======================================================================
+    // output
+
+    static void printSummary(const std::vector<Row>& rows)
+    {
+        std::println();
+        std::println("Throughput [million ops/sec] - {} blocks of {} bytes (Mixed: {} .. {} bytes)",
+            Count, BlockSize, MinMixedSize, MaxMixedSize);
+        std::println();
+
+        std::print("{:<30}", "Allocator");
+        for (auto name : WorkloadNames) {
+            std::print("{:>11}", name);
+        }
+        std::println();
+
+        for (const auto& row : rows) {
+            std::print("{:<30}", row.m_name);
+            for (const auto& result : row.m_results) {
+                if (!result.m_supported) {
+                    std::print("{:>11}", "n/a");
+                }
+                else if (result.m_failed) {
+                    std::print("{:>11}", "failed");
+                }
+                else {
+                    std::print("{:>11.2f}", result.m_opsPerSec / 1'000'000.0);
+                }
+            }
+            std::println();
+        }
+    }
+
+    static void printDetails(const std::vector<Row>& rows)
+    {
+        for (std::size_t i{}; i != Workloads.size(); ++i) {
+
+            std::println();
+            std::println("Workload: {}", WorkloadNames[i]);
+            std::println("{:<30}{:>14}{:>10}{:>16}{:>15}", "Allocator", "Mops/sec", "p99 [ns]", "Peak RSS [KiB]", "Fragmentation");
+
+            for (const auto& row : rows) {
+
+                const auto& result{ row.m_results[i] };
+
+                if (!result.m_supported || result.m_failed) {
+                    std::println("{:<30}{:>14}", row.m_name, result.m_failed ? "failed" : "n/a");
+                    continue;
+                }
+
+                std::print("{:<30}{:>14.2f}{:>10.0f}", row.m_name, result.m_opsPerSec / 1'000'000.0, result.m_p99);
+
+                if (result.m_peakRSS >= 0) {
+                    std::print("{:>16}", result.m_peakRSS / 1024);
+                }
+                else {
+                    std::print("{:>16}", "-");
+                }
+
+                if (result.m_fragmentation >= 0.0) {
+                    std::println("{:>14.1f}%", 100.0 * result.m_fragmentation);
+                }
+                else {
+                    std::println("{:>15}", "-");
+                }
+            }
+        }
+    }
+
+    static void allocator_benchmark_suite()
+    {
+        // keep the allocators silent during the measurements
+        CustomAllocatorTracing = false;
+
+        std::vector<Row> rows;
+
+        rows.push_back(measureAll<StdAllocatorAdapter>());
+        rows.push_back(measureAll<CustomAllocatorAdapter>());
+        rows.push_back(measureAll<FixedBlockMemoryManagerAdapter>());
+        rows.push_back(measureAll<FixedArenaResourceAdapter>());
+        rows.push_back(measureAll<TrackingResourceAdapter>());
+        rows.push_back(measureAll<UnsynchronizedPoolAdapter>());
+        rows.push_back(measureAll<SynchronizedPoolAdapter>());
+        rows.push_back(measureAll<MonotonicBufferAdapter>());
+        rows.push_back(measureAll<FixedSizeObjectPoolAdapter>());
+        rows.push_back(measureAll<DynamicSizeObjectPoolAdapter>());
+        rows.push_back(measureAll<ThreadSafeObjectPoolAdapter>());
+
+        CustomAllocatorTracing = true;
+
+        printSummary(rows);
+        printDetails(rows);
+    }
+}
+
+void main_allocator_benchmark_suite()
+{
+    AllocatorBenchmarkSuite::allocator_benchmark_suite();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -4,31 +4,103 @@
 
 #pragma once
 
-#include <cstddef>      // std::size_t
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint32_t
 #include <string_view>  // std::string_view
 #include <format>       // std::std::formatter
 
 namespace COWString
 {
+    // owner thread of control blocks (see CowStringImpl.cpp)
+    struct ThreadState;
+
+    // Small strings (up to 'SmallCapacity' characters) are stored inline,
+    // only long strings are stored in a shared, reference counted buffer.
+    //
+    // Layout (24 bytes):
+    //   small: characters and terminating '\0', the last byte holds SmallCapacity - length
+    //          (so for a string of length 23 the last byte is the terminating '\0')
+    //   long:  Controlblock*, followed by the length and the offset into the buffer
+    //          of the control block (32 bit); the last byte holds LongTag
+    //
+    // Slices (substr) share the buffer of the parent string: same control block, different offset and length.
+    // A slice is '\0'-terminated only, if it ends at the end of the buffer - for any other slice c_str() copies
+    // the characters into a buffer of its own first. The value doesn't change, only the representation:
+    // that's why m_storage is mutable. As this is a write access, c_str() of such a slice must not be called
+    // concurrently on the same object - data() and the string_view conversion never copy.
+    //
+    // The fields are accessed with std::memcpy: well defined, and compiled to plain loads and stores.
+    //
+    // Biased reference counting (copies of long strings may be shared between threads):
+    //   The thread, that created a control block, counts its references non-atomically ('m_biased'),
+    //   all other threads count atomically ('m_shared': count in the upper bits, flags in the two lowest bits).
+    //   The total number of references is the sum of both counts - so 'm_shared' may become negative,
+    //   when another thread releases a reference, that the owner thread has taken.
+    //   When 'm_biased' drops to zero, the counts are merged: from then on only 'm_shared' is used.
+    //   When 'm_shared' drops below zero, the control block is queued to the owner thread, which merges
+    //   the counts - on its next allocation, in 'mergeQueuedReferences' or when the thread exits.
+
     class CowString
     {
     private:
+        friend struct ThreadState;
+
         struct Controlblock
         {
-            std::size_t       m_refCount;
+            ThreadState*                 m_owner;
+            std::size_t                  m_biased;     // accessed by the owner thread only
+            std::atomic<std::ptrdiff_t>  m_shared;
+            std::size_t                  m_length;     // length of the buffer
 
-            static Controlblock* create();
+            static constexpr std::ptrdiff_t Queued     { 1 };
+            static constexpr std::ptrdiff_t Merged     { 2 };
+            static constexpr int            CountShift { 2 };
+            static constexpr std::ptrdiff_t One        { std::ptrdiff_t{ 1 } << CountShift };
+
+            static Controlblock* create(std::size_t length);   // buffer not initialized
             static Controlblock* create(const char* src, std::size_t length);
+
+            char* data();
+
+            void addReference();
+            void releaseReference();
+            bool isShared();
+            void merge();
+            void destroy();
         };
 
-        Controlblock*         m_ptr;
-        char*                 m_str;
-        std::size_t           m_len;
+        static constexpr std::size_t   StorageSize   { 24 };
+        static constexpr std::size_t   SmallCapacity { StorageSize - 1 };
+        static constexpr unsigned char LongTag       { 0xFF };
+
+        static constexpr std::size_t   OffsetOfLength { sizeof(Controlblock*) };
+        static constexpr std::size_t   OffsetOfOffset { OffsetOfLength + sizeof(std::size_t) };
+
+        static_assert(OffsetOfOffset + sizeof(std::uint32_t) <= SmallCapacity, "long representation overlaps the tag");
+
+        alignas(Controlblock*) mutable char m_storage[StorageSize];     // mutable: c_str() of a slice
+
+        // helper methods - internal state
+        void          init         (const char* s, std::size_t length);
+        void          release      ();
+        void          setEmpty     ();
+        void          setLong      (Controlblock* cb, std::size_t length, std::uint32_t offset);
+
+        bool          isLong       () const;
+        Controlblock* block        () const;
+        std::size_t   longSize     () const;
+        std::uint32_t longOffset   () const;
+        char*         mutableData  ();
+        char*         allocate     (std::size_t length);
 
         // ensure we have a private (unshared) copy before writing
         void detach           ();
+        void unshare          ();
 
     public:
+        static constexpr std::size_t npos{ static_cast<std::size_t>(-1) };
+
         // c'tor(s), d'tor
         CowString             ();
         explicit CowString    (const char* s);
@@ -46,8 +118,22 @@ namespace COWString
 
         // getter
         std::size_t  size     () const;
-        const char*  c_str    () const;
+        const char*  data     () const;   // not '\0'-terminated, if this is a slice
+        const char*  c_str    () const;   // copies a slice, that isn't '\0'-terminated
         bool         empty    () const;
+        bool         isSmall  () const;   // stored inline, never shared
+        bool         isSlice  () const;   // shares a part of the buffer of another string
+
+        // slice - shares the buffer, no allocation (a short substring is stored inline)
+        CowString    substr   (std::size_t pos, std::size_t count = npos) const;
+
+        // creates a string of 'length' characters with a single allocation (or none for a small string):
+        // 'fill' writes the characters into the buffer - void fill(char* buffer)
+        template <typename TFill>
+        static CowString createWith(std::size_t length, TFill fill);
+
+        // merges the reference counts of control blocks, that other threads have queued to the calling thread
+        static void mergeQueuedReferences();
 
         // type-conversion operator
         operator std::string_view() const;
@@ -64,6 +150,14 @@ namespace COWString
         char at (std::size_t pos) const;          // read-only access
         char& at(std::size_t pos);                // possible write access - triggers COW
     };
+
+    template <typename TFill>
+    inline CowString CowString::createWith(std::size_t length, TFill fill)
+    {
+        CowString result{};
+        fill(result.allocate(length));
+        return result;
+    }
 }
 
 namespace std
@@ -98,9 +192,9 @@ namespace std
             return ctx.begin(); // returns position of '}'
         }
 
-        // format by always writing its 'char*' value
+        // format by writing its characters (a slice isn't '\0'-terminated)
         auto format(const CowString& obj, std::format_context & ctx) const {
-            return std::format_to(ctx.out(), "{}", obj.c_str());
+            return std::format_to(ctx.out(), "{}", std::string_view{ obj });
         }
     };
 }
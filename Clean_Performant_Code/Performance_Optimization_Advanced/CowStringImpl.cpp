@@ -6,82 +6,399 @@
 
 #include <print>
 
-#include <cstring>     // std::strlen
+#include <algorithm>   // std::min
+#include <cstring>     // std::strlen, std::memcpy
+#include <limits>      // std::numeric_limits
+#include <mutex>       // std::mutex, std::lock_guard
 #include <stdexcept>   // std::out_of_range
+#include <vector>      // std::vector
 
 namespace COWString
 {
+    static_assert(sizeof(CowString) <= 24, "CowString must not be larger than 24 bytes");
+
+    // =================================================================================
+    // ThreadState: owner of control blocks
+    //
+    // A ThreadState lives as long as its thread or any control block owned by it.
+    // When the thread exits, the state is closed: from then on, control blocks queued
+    // to it are merged by the thread, that queues them (the biased counts don't change anymore).
+
+    struct ThreadState
+    {
+        using Controlblock = CowString::Controlblock;
+
+        std::mutex                   m_mutex;
+        std::vector<Controlblock*>   m_queue;
+        bool                         m_closed{ false };
+        std::atomic<bool>            m_hasQueued{ false };
+        std::atomic<std::size_t>     m_references{ 1 };   // the thread itself and its control blocks
+
+        // state of the calling thread - nullptr, if it has none (yet) or the thread is exiting
+        static ThreadState* current();
+        static ThreadState* acquire();
+
+        void enqueue(Controlblock* cb);
+        void drain();
+        void close();
+        void release();
+    };
+
+    static thread_local ThreadState* t_threadState{ nullptr };
+    static thread_local bool         t_threadExited{ false };
+
+    namespace {
+
+        // closes the state of a thread, when the thread exits
+        struct ThreadStateHolder
+        {
+            ThreadState* m_state;
+
+            ThreadStateHolder() : m_state{ new ThreadState{} } { t_threadState = m_state; }
+
+            ~ThreadStateHolder() {
+                t_threadState = nullptr;
+                t_threadExited = true;
+                m_state->close();
+                m_state->release();
+            }
+        };
+    }
+
+    ThreadState* ThreadState::current()
+    {
+        return t_threadState;
+    }
+
+    ThreadState* ThreadState::acquire()
+    {
+        if (t_threadState == nullptr && !t_threadExited) {
+            static thread_local ThreadStateHolder holder{};
+        }
+
+        return t_threadState;
+    }
+
+    void ThreadState::enqueue(Controlblock* cb)
+    {
+        {
+            std::lock_guard<std::mutex> guard{ m_mutex };
+
+            if (!m_closed) {
+                m_queue.push_back(cb);
+                m_hasQueued.store(true, std::memory_order_release);
+                return;
+            }
+        }
+
+        // the owner thread has exited
+        cb->merge();
+    }
+
+    void ThreadState::drain()
+    {
+        std::vector<Controlblock*> queue;
+        {
+            std::lock_guard<std::mutex> guard{ m_mutex };
+            queue.swap(m_queue);
+            m_hasQueued.store(false, std::memory_order_relaxed);
+        }
+
+        for (Controlblock* cb : queue) {
+            cb->merge();
+        }
+    }
+
+    void ThreadState::close()
+    {
+        std::vector<Controlblock*> queue;
+        {
+            std::lock_guard<std::mutex> guard{ m_mutex };
+            queue.swap(m_queue);
+            m_closed = true;
+        }
+
+        for (Controlblock* cb : queue) {
+            cb->merge();
+        }
+    }
+
+    void ThreadState::release()
+    {
+        if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
     // =================================================================================
     // Controlblock
 
-    CowString::Controlblock* CowString::Controlblock::create()
+    CowString::Controlblock* CowString::Controlblock::create(std::size_t len)
     {
-        void* mem{ ::operator new(sizeof(Controlblock) + 1) };
-        Controlblock* cb{ new (mem) Controlblock{ 1 } };
-        char* cp{ reinterpret_cast<char*> (mem) + sizeof(Controlblock) };
-        cp[0] = '\0';
+        ThreadState* owner{ ThreadState::acquire() };
+
+        // the owner thread merges queued control blocks, before it allocates a new one
+        if (owner != nullptr && owner->m_hasQueued.load(std::memory_order_relaxed)) {
+            owner->drain();
+        }
+
+        void* mem{ ::operator new(sizeof(Controlblock) + len + 1) };
+
+        if (owner != nullptr) {
+            owner->m_references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // without an owner thread the counts are merged right from the start
+        Controlblock* cb{ new (mem) Controlblock{ 
+            owner, 
+            (owner != nullptr) ? std::size_t{ 1 } : std::size_t{ 0 },
+            (owner != nullptr) ? std::ptrdiff_t{ 0 } : One | Merged,
+            len
+        } };
+
+        reinterpret_cast<char*> (mem)[sizeof(Controlblock) + len] = '\0';
         return cb;
     }
 
     CowString::Controlblock* CowString::Controlblock::create(const char* src, std::size_t len)
     {
-        void* mem{ ::operator new(sizeof(Controlblock) + len + 1) };
-        Controlblock* cb{ new (mem) Controlblock{ 1 } };
-        char* cp{ reinterpret_cast<char*> (mem) + sizeof(Controlblock) };
-        std::memcpy(cp, src, len);
-        cp[len] = '\0';
+        Controlblock* cb{ create(len) };
+        std::memcpy(cb->data(), src, len);
         return cb;
     }
 
+    char* CowString::Controlblock::data()
+    {
+        return reinterpret_cast<char*> (this) + sizeof(Controlblock);
+    }
+
+    void CowString::Controlblock::addReference()
+    {
+        if (m_owner == ThreadState::current() && m_biased != 0) {
+            ++m_biased;
+        }
+        else {
+            m_shared.fetch_add(One, std::memory_order_relaxed);
+        }
+    }
+
+    void CowString::Controlblock::releaseReference()
+    {
+        if (m_owner == ThreadState::current() && m_biased != 0) {
+
+            if (--m_biased == 0) {
+
+                // the owner thread has released all of its references: merge the counts
+                std::ptrdiff_t old{ m_shared.fetch_or(Merged, std::memory_order_acq_rel) };
+
+                // if the block is queued, the queue finishes the merge
+                if ((old & Queued) == 0 && (old >> CountShift) == 0) {
+                    destroy();
+                }
+            }
+
+            return;
+        }
+
+        std::ptrdiff_t old{ m_shared.load(std::memory_order_relaxed) };
+        std::ptrdiff_t desired{};
+        bool queue{};
+
+        do {
+            desired = old - One;
+            queue = false;
+
+            // negative count: the owner thread holds the missing references - it has to merge the counts
+            if ((old & (Merged | Queued)) == 0 && desired < 0) {
+                desired |= Queued;
+                queue = true;
+            }
+        } 
+        while (!m_shared.compare_exchange_weak(old, desired, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        if (queue) {
+            m_owner->enqueue(this);
+        }
+        else if ((desired & (Merged | Queued)) == Merged && (desired >> CountShift) == 0) {
+            destroy();
+        }
+    }
+
+    // total number of references > 1?
+    // Note: a single reference can't be shared concurrently by another thread,
+    // so a result of 'false' is stable - 'true' might be outdated, which only costs a needless copy.
+    // Other threads can't read the biased count: until the counts are merged, the block counts as shared.
+    bool CowString::Controlblock::isShared()
+    {
+        std::ptrdiff_t shared{ m_shared.load(std::memory_order_acquire) };
+
+        if (m_owner == ThreadState::current() && m_biased != 0) {
+            return static_cast<std::ptrdiff_t>(m_biased) + (shared >> CountShift) > 1;
+        }
+
+        return (shared & Merged) == 0 || (shared >> CountShift) > 1;
+    }
+
+    // called by the owner thread - or by any thread, once the owner thread has exited
+    void CowString::Controlblock::merge()
+    {
+        const std::ptrdiff_t biased{ static_cast<std::ptrdiff_t>(m_biased) };
+        m_biased = 0;
+
+        std::ptrdiff_t old{ m_shared.load(std::memory_order_relaxed) };
+        std::ptrdiff_t desired{};
+
+        do {
+            desired = ((old + biased * One) | Merged) & ~Queued;
+        } 
+        while (!m_shared.compare_exchange_weak(old, desired, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        if ((desired >> CountShift) == 0) {
+            destroy();
+        }
+    }
+
+    void CowString::Controlblock::destroy()
+    {
+        ThreadState* owner{ m_owner };
+
+        this->~Controlblock();
+        ::operator delete(this);
+
+        if (owner != nullptr) {
+            owner->release();
+        }
+    }
+
+    void CowString::mergeQueuedReferences()
+    {
+        if (ThreadState* state{ ThreadState::current() }; state != nullptr) {
+            state->drain();
+        }
+    }
+
+    // =================================================================================
+    // helper methods - internal state
+
+    void CowString::init(const char* s, std::size_t length)
+    {
+        if (length <= SmallCapacity) {
+            // small string: no allocation
+            std::memcpy(m_storage, s, length);
+            m_storage[length] = '\0';
+            m_storage[SmallCapacity] = static_cast<char>(SmallCapacity - length);
+        }
+        else {
+            setLong(Controlblock::create(s, length), length, 0);
+        }
+    }
+
+    // 'this' must be empty: provides a buffer for 'length' characters (terminating '\0' included)
+    char* CowString::allocate(std::size_t length)
+    {
+        if (length <= SmallCapacity) {
+            m_storage[length] = '\0';
+            m_storage[SmallCapacity] = static_cast<char>(SmallCapacity - length);
+            return m_storage;
+        }
+
+        Controlblock* cb{ Controlblock::create(length) };
+        setLong(cb, length, 0);
+        return cb->data();
+    }
+
+    void CowString::setLong(Controlblock* cb, std::size_t length, std::uint32_t offset)
+    {
+        std::memcpy(m_storage, &cb, sizeof(cb));
+        std::memcpy(m_storage + OffsetOfLength, &length, sizeof(length));
+        std::memcpy(m_storage + OffsetOfOffset, &offset, sizeof(offset));
+        m_storage[SmallCapacity] = static_cast<char>(LongTag);
+    }
+
+    void CowString::release()
+    {
+        if (isLong()) {
+            block()->releaseReference();
+        }
+    }
+
+    void CowString::setEmpty()
+    {
+        m_storage[0] = '\0';
+        m_storage[SmallCapacity] = static_cast<char>(SmallCapacity);
+    }
+
+    bool CowString::isLong() const
+    {
+        return static_cast<unsigned char>(m_storage[SmallCapacity]) == LongTag;
+    }
+
+    CowString::Controlblock* CowString::block() const
+    {
+        Controlblock* cb;
+        std::memcpy(&cb, m_storage, sizeof(cb));
+        return cb;
+    }
+
+    std::size_t CowString::longSize() const
+    {
+        std::size_t len;
+        std::memcpy(&len, m_storage + OffsetOfLength, sizeof(len));
+        return len;
+    }
+
+    std::uint32_t CowString::longOffset() const
+    {
+        std::uint32_t offset;
+        std::memcpy(&offset, m_storage + OffsetOfOffset, sizeof(offset));
+        return offset;
+    }
+
+    char* CowString::mutableData()
+    {
+        return isLong() ? block()->data() + longOffset() : m_storage;
+    }
+
     // =================================================================================
     // c'tor(s) / d'tor
 
     CowString::CowString()
     {
-        m_ptr = Controlblock::create();
-        m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
-        m_len = 0;
+        // the empty string is a small string - no allocation
+        setEmpty();
     }
 
     CowString::CowString(const char* s)
     {
-        m_len = std::strlen(s);
-        m_ptr = Controlblock::create(s, m_len);
-        m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
+        init(s, std::strlen(s));
     }
 
     CowString::CowString(const char* s, std::size_t length)
     {
-        m_ptr = Controlblock::create(s, length);
-        m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
-        m_len = length;
+        init(s, length);
     }
 
     CowString::CowString(std::string_view sv)
     {
-        m_ptr = Controlblock::create(sv.data(), sv.size());
-        m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
-        m_len = sv.size();
+        init(sv.data(), sv.size());
     }
 
     CowString::~CowString()
     {
-        if (m_ptr != nullptr) {
-
-            m_ptr->m_refCount--;
-            if (m_ptr->m_refCount == 0) {
-                ::operator delete(m_ptr);
-            }
-        }
+        release();
     }
 
     // =================================================================================
     // copy semantics
 
     CowString::CowString(const CowString& other)
-        : m_ptr{ other.m_ptr }, m_str{ other.m_str }, m_len{ other.m_len }
     {
-        m_ptr->m_refCount++;
+        // small strings are copied, long strings are shared
+        std::memcpy(m_storage, other.m_storage, StorageSize);
+
+        if (isLong()) {
+            block()->addReference();
+        }
     }
 
     // assignment operator
@@ -89,16 +406,13 @@ namespace COWString
     {
         if (this != &other) {
 
-            m_ptr->m_refCount--;
-            if (m_ptr->m_refCount == 0) {
-                ::operator delete(m_ptr);
-            }
+            release();
 
-            m_ptr = other.m_ptr;
-            m_str = other.m_str;
-            m_len = other.m_len;
+            std::memcpy(m_storage, other.m_storage, StorageSize);
 
-            m_ptr->m_refCount++;
+            if (isLong()) {
+                block()->addReference();
+            }
         }
 
         return *this;
@@ -107,30 +421,21 @@ namespace COWString
     // =================================================================================
     // move semantics
 
-    CowString::CowString(CowString&& other) noexcept 
-        : m_ptr{ other.m_ptr }, m_str{ other.m_str }, m_len{ other.m_len }
+    CowString::CowString(CowString&& other) noexcept
     {
-        other.m_ptr = Controlblock::create();
-        other.m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
-        other.m_len = 0;
+        // take over the representation, 'other' becomes an empty (small) string
+        std::memcpy(m_storage, other.m_storage, StorageSize);
+        other.setEmpty();
     }
 
     CowString& CowString::operator=(CowString&& other) noexcept {
 
         if (this != &other) {
 
-            m_ptr->m_refCount--;
-            if (m_ptr->m_refCount == 0) {
-                ::operator delete(m_ptr);
-            }
-
-            m_ptr = other.m_ptr;
-            m_str = other.m_str;
-            m_len = other.m_len;
+            release();
 
-            other.m_ptr = Controlblock::create();
-            other.m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
-            other.m_len = 0;
+            std::memcpy(m_storage, other.m_storage, StorageSize);
+            other.setEmpty();
         }
     
         return *this;
@@ -139,43 +444,92 @@ namespace COWString
     // =================================================================================
     // getter
 
-    std::size_t CowString::size() const { return m_len; }
+    std::size_t CowString::size() const {
+        return isLong() ? longSize() : SmallCapacity - static_cast<unsigned char>(m_storage[SmallCapacity]);
+    }
+
+    const char* CowString::data() const
+    {
+        return isLong() ? block()->data() + longOffset() : m_storage;
+    }
+
+    const char* CowString::c_str() const
+    {
+        // a slice is '\0'-terminated, if it ends at the end of the buffer -
+        // otherwise the (mutable) representation changes, not the value
+        if (isLong() && longOffset() + longSize() != block()->m_length) {
+            const_cast<CowString*>(this)->unshare();
+        }
+
+        return data();
+    }
+
+    bool CowString::empty() const { return size() == 0; }
+
+    bool CowString::isSmall() const { return !isLong(); }
+
+    bool CowString::isSlice() const
+    {
+        return isLong() && longSize() != block()->m_length;
+    }
+
+    // =================================================================================
+    // slices
+
+    CowString CowString::substr(std::size_t pos, std::size_t count) const
+    {
+        const std::size_t length{ size() };
+
+        if (pos > length) {
+            throw std::out_of_range("position out of range!");
+        }
+
+        count = std::min(count, length - pos);
+
+        const std::size_t offset{ isLong() ? longOffset() + pos : 0 };
 
-    const char* CowString::c_str() const { return m_str; }
+        // short substrings are stored inline, offsets beyond 32 bit need a copy
+        if (count <= SmallCapacity || offset > std::numeric_limits<std::uint32_t>::max()) {
+            return CowString{ data() + pos, count };
+        }
 
-    bool CowString::empty() const { return m_len == 0; }
+        CowString slice{};
+        block()->addReference();
+        slice.setLong(block(), count, static_cast<std::uint32_t>(offset));
+        return slice;
+    }
 
     // =================================================================================
     // read-only access / write access (triggers COW)
 
     // read-only access
     char CowString::operator[](std::size_t pos) const {
-        return m_str[pos];
+        return data()[pos];
     }
 
     // possible write access - triggers COW
     char& CowString::operator[](std::size_t pos) {
         detach();
-        return m_str[pos];
+        return mutableData()[pos];
     }
 
     // read-only access
     char CowString::at(std::size_t pos) const {
-        if (pos >= m_len) {
+        if (pos >= size()) {
             throw std::out_of_range("index out of range!");
         }
             
-        return m_str[pos];
+        return data()[pos];
     }
 
     // possible write access - triggers COW
     char& CowString::at(std::size_t pos) {
-        if (pos >= m_len) {
+        if (pos >= size()) {
             throw std::out_of_range("index out of range!");
         }
             
         detach();
-        return m_str[pos];
+        return mutableData()[pos];
     }
 
     // =================================================================================
@@ -183,15 +537,16 @@ namespace COWString
 
     bool operator==(const CowString& a, const CowString& b) {
 
-        if (a.m_ptr == b.m_ptr) {
-            return true;
-        }
-
         if (a.size() != b.size()) {
             return false;
         }
 
-        return std::memcmp(a.c_str(), b.c_str(), a.size()) == 0;
+        // same buffer (and same offset)
+        if (a.data() == b.data()) {
+            return true;
+        }
+
+        return std::memcmp(a.data(), b.data(), a.size()) == 0;
     }
 
     bool operator!=(const CowString& a, const CowString& b) {
@@ -199,7 +554,7 @@ namespace COWString
     }
 
     bool operator<(const CowString& a, const CowString& b) {
-        return std::strcmp(a.c_str(), b.c_str()) < 0;
+        return std::string_view{ a } < std::string_view{ b };
     }
 
     // =================================================================================
@@ -207,26 +562,29 @@ namespace COWString
 
     CowString::operator std::string_view() const
     {
-        return { m_str , m_len };
+        return { data(), size() };
     }
 
     // =================================================================================
     // ensure we have a private (unshared) copy before writing
     // (switching from state 'shared' into state 'owning')
+    // Note: small strings are never shared
 
     void CowString::detach()
     {
-        if (m_ptr->m_refCount > 1) {
+        if (isLong() && block()->isShared()) {
+            unshare();
+        }
+    }
 
-            Controlblock* old{ m_ptr };
-            
-            std::size_t len{ std::strlen(m_str) };
-            m_ptr = Controlblock::create(m_str, m_len);
-            m_str = reinterpret_cast<char*> (m_ptr) + sizeof(Controlblock);
-            m_len = len;
+    // copy the characters (of a slice) into a buffer of its own
+    void CowString::unshare()
+    {
+        Controlblock* old{ block() };
 
-            old->m_refCount--;
-        }
+        setLong(Controlblock::create(data(), longSize()), longSize(), 0);
+
+        old->releaseReference();
     }
 };
 
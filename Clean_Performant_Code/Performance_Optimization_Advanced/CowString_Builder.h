@@ -0,0 +1,85 @@
+// =====================================================================================
+// CowString_Builder.h // Simple implementation of a COW string class
+// =====================================================================================
+
+#pragma once
+
+#include "CowString.h"
+
+#include <charconv>     // std::to_chars
+#include <cstddef>      // std::size_t
+#include <cstring>      // std::memcpy
+#include <string_view>  // std::string_view
+#include <type_traits>  // std::is_arithmetic_v, std::is_same_v
+
+namespace COWString
+{
+    // concat: concatenates all pieces into a new CowString with a single allocation
+    //
+    //   CowString line{ concat("[", level, "] ", component, ": ", message, " (", id, ")") };
+    //
+    // Pieces: everything convertible to std::string_view (CowString, std::string, const char*, ...),
+    // single characters and numbers (formatted with std::to_chars).
+    // All pieces are converted first, so the total length is known before the allocation -
+    // then each piece is copied into the buffer with std::memcpy. No temporaries, no reallocation.
+
+    namespace Builder
+    {
+        // formatted number - long enough for the shortest representation of any double
+        class NumberPiece
+        {
+        private:
+            char         m_buffer[32];
+            std::size_t  m_length;
+
+        public:
+            template <typename T>
+            explicit NumberPiece(T value)
+            {
+                auto [ptr, ec] = std::to_chars(m_buffer, m_buffer + sizeof(m_buffer), value);
+                m_length = static_cast<std::size_t>(ptr - m_buffer);
+            }
+
+            const char* data() const { return m_buffer; }
+            std::size_t size() const { return m_length; }
+        };
+
+        template <typename T>
+        inline auto makePiece(const T& value)
+        {
+            if constexpr (std::is_same_v<T, char>) {
+                return std::string_view{ &value, 1 };
+            }
+            else if constexpr (std::is_same_v<T, bool>) {
+                return std::string_view{ value ? "true" : "false" };
+            }
+            else if constexpr (std::is_arithmetic_v<T>) {
+                return NumberPiece{ value };
+            }
+            else {
+                return std::string_view{ value };
+            }
+        }
+
+        template <typename ... TPieces>
+        inline CowString concatPieces(const TPieces& ... pieces)
+        {
+            const std::size_t length{ (std::size_t{} + ... + pieces.size()) };
+
+            return CowString::createWith(length, [&] (char* buffer) {
+                ((std::memcpy(buffer, pieces.data(), pieces.size()), buffer += pieces.size()), ...);
+            });
+        }
+    }
+
+    template <typename ... TArgs>
+    inline CowString concat(const TArgs& ... args)
+    {
+        // the pieces live until the end of the full expression - as long as 'concatPieces' needs them
+        return Builder::concatPieces(Builder::makePiece(args) ...);
+    }
+}
+
+// =====================================================================================
+// End-of-File
+// =====================================================================================
@@ -0,0 +1,115 @@
+// =====================================================================================
+// CowString_Builder_Test.cpp // Simple implementation of a COW string class
+// =====================================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "CowString.h"
+#include "CowString_Builder.h"
+
+#include <cstddef>
+#include <format>
+#include <print>
+#include <string>
+#include <string_view>
+
+namespace CowString_Builder_SimpleTest {
+
+    using namespace COWString;
+
+    static void main_cow_string_builder_01()
+    {
+        CowString component{ "Network" };
+        std::string message{ "connection established" };
+
+        CowString line{ concat('[', "INFO", "] ", component, ": ", message, " (id ", 4711, ", ", 2.5, " ms)") };
+
+        std::println("{} - length: {} - small: {}", line, line.size(), line.isSmall());
+
+        // short results need no allocation at all
+        CowString key{ concat("user:", 42, ':', true) };
+
+        std::println("{} - length: {} - small: {}", key, key.size(), key.isSmall());
+    }
+}
+
+namespace CowString_Builder_Benchmark {
+
+    using namespace COWString;
+
+#ifdef _DEBUG
+    static constexpr std::size_t Iterations = 100'000;       // debug
+#else
+    static constexpr std::size_t Iterations = 1'000'000;     // release
+#endif
+
+    static constexpr std::string_view Levels[]{ "INFO", "WARN", "ERROR" };
+
+    // builds a log line: "[<level>] <component>: <message> (id <id>)"
+    static void main_cow_string_builder_20()
+    {
+        const std::string component{ "Network" };
+        const std::string message{ "connection to remote host established" };
+
+        std::println("Building {} log lines", Iterations);
+
+        std::size_t length{};
+
+        std::println("std::string - operator+ (one temporary per step):");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                std::string line{ "[" + std::string{ Levels[i % 3] } + "] " + component + ": " + message + " (id " + std::to_string(i) + ")" };
+                length += line.size();
+            }
+        }
+
+        std::println("std::string - reserve and append:");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                const std::string id{ std::to_string(i) };
+
+                std::string line;
+                line.reserve(1 + Levels[i % 3].size() + 2 + component.size() + 2 + message.size() + 4 + id.size() + 1);
+                line.append("[").append(Levels[i % 3]).append("] ").append(component).append(": ").append(message).append(" (id ").append(id).append(")");
+                length += line.size();
+            }
+        }
+
+        std::println("std::format:");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                std::string line{ std::format("[{}] {}: {} (id {})", Levels[i % 3], component, message, i) };
+                length += line.size();
+            }
+        }
+
+        std::println("CowString - concat (single allocation):");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                CowString line{ concat('[', Levels[i % 3], "] ", component, ": ", message, " (id ", i, ')') };
+                length += line.size();
+            }
+        }
+
+        std::println("Total length: {}", length);
+    }
+}
+
+void main_cow_string_builder()
+{
+    CowString_Builder_SimpleTest::main_cow_string_builder_01();
+
+    CowString_Builder_Benchmark::main_cow_string_builder_20();
+}
+
+// =====================================================================================
+// End-of-File
+// =====================================================================================
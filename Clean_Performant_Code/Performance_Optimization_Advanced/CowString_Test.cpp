@@ -15,6 +15,7 @@
 
 #include "CowString.h"
 
+#include <cstring>
 #include <print>
 #include <string_view>
 #include <vector>
@@ -66,15 +67,18 @@ namespace COWString
         std::println();
     }
 
+    // Note: strings up to 23 characters are stored inline and never shared,
+    // the following examples use longer strings to demonstrate copy-on-write
+
     static void main_cow_string_05()
     {
-        CowString a{ "1234567890" };
+        CowString a{ "Lorem ipsum dolor sit amet, consectetur" };
         CowString b{ a };
     }
 
     static void main_cow_string_06()
     {
-        CowString a{ "1234567890" };
+        CowString a{ "Lorem ipsum dolor sit amet, consectetur" };
         CowString b{ a };
         CowString c{ a };
 
@@ -83,11 +87,11 @@ namespace COWString
 
     static void main_cow_string_07()
     {
-        CowString a{ "1234567890" };
+        CowString a{ "Lorem ipsum dolor sit amet, consectetur" };
         CowString b{ a };
         CowString c{ a };
 
-        CowString x{ "ABC" };
+        CowString x{ "ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
         CowString y{ x };
 
         a = x;
@@ -95,7 +99,7 @@ namespace COWString
 
     static void main_cow_string_08()
     {
-        CowString a{ "Hello World" };
+        CowString a{ "Hello World - Hello Universe" };
         CowString b{ a };  // shares buffer
         CowString c{ b };  // shares buffer
 
@@ -175,10 +179,51 @@ namespace COWString
         }
     }
 
+    static void main_cow_string_13()
+    {
+        // small string optimization
+        CowString a{};
+        CowString b{ "1234567890" };
+        CowString c{ "12345678901234567890123" };
+        CowString d{ "123456789012345678901234" };
+
+        std::println("sizeof(CowString): {}", sizeof(CowString));
+        std::println("Length: {:>2} - small: {}", a.size(), a.isSmall());
+        std::println("Length: {:>2} - small: {}", b.size(), b.isSmall());
+        std::println("Length: {:>2} - small: {}", c.size(), c.isSmall());
+        std::println("Length: {:>2} - small: {}", d.size(), d.isSmall());
+    }
+
+    static void main_cow_string_14()
+    {
+        // slices share the buffer of the parent string
+        CowString text{ "The quick brown fox jumps over the lazy dog, again and again and again" };
+
+        CowString head{ text.substr(0, 43) };
+        CowString tail{ text.substr(20) };
+        CowString word{ text.substr(4, 5) };   // short: stored inline
+
+        std::println("head: {} - slice: {}", head, head.isSlice());
+        std::println("tail: {} - slice: {}", tail, tail.isSlice());
+        std::println("word: {} - small: {}", word, word.isSmall());
+
+        head[0] = 't';                          // copies the slice only
+
+        std::println("head: {} - slice: {}", head, head.isSlice());
+        std::println("text: {}", text);
+        std::println("c_str of tail: {}", tail.c_str());   // 'tail' ends at the end of the buffer: no copy
+
+        // c_str() of a const slice, that isn't '\0'-terminated: copies the characters
+        const CowString middle{ text.substr(10, 30) };
+        const char* s{ middle.c_str() };
+        std::println("c_str of middle: {} - length: {} - slice: {}", s, std::strlen(s), middle.isSlice());
+        std::println("text: {}", text);
+    }
+
     // pitfalls
     static void main_cow_string_20()
     {
-        CowString a{ "Hello" };
+        CowString a{ "Hello World - Hello Universe" };
         std::println("a: {}", a);
 
         char& ch = a[0];            // Non-const detachment does nothing here
@@ -194,7 +239,7 @@ namespace COWString
 
     static void main_cow_string_21()
     {
-        /*const*/ CowString s{ "1234567890" };
+        /*const*/ CowString s{ "Lorem ipsum dolor sit amet, consectetur" };
         const char* p{ s.c_str() };
 
         {
@@ -209,7 +254,7 @@ namespace COWString
 
     static void main_cow_string_22()
     {
-        CowString s{ "1234567890" };
+        CowString s{ "Lorem ipsum dolor sit amet, consectetur" };
         const char* p{ s.c_str() };
 
         CowString other{ s };
@@ -251,6 +296,8 @@ void main_cow_string()
     main_cow_string_10();
     main_cow_string_11();
     main_cow_string_12();
+    main_cow_string_13();
+    main_cow_string_14();
 
     main_cow_string_20();
     main_cow_string_21();     // fails - by design
@@ -20,6 +20,12 @@ void main_cow_textfile_statistics_01()
     std::println();
     stats.countWordFrequenciesCOW();
     std::println();
+    stats.countWordFrequenciesSlices();
+    std::println();
+    stats.countWordFrequenciesParallel();
+    std::println();
+    stats.countWordFrequenciesIncremental();
+    std::println();
 }
 
 void main_cow_textfile_statistics_02()
@@ -22,6 +22,9 @@ public:
     // public interface
     void countWordFrequencies        ();
     void countWordFrequenciesCOW     ();
+    void countWordFrequenciesSlices  ();
+    void countWordFrequenciesParallel();
+    void countWordFrequenciesIncremental();
     void computeMostFrequentWords    ();
     void computeMostFrequentWordsCOW ();
 };
@@ -6,15 +6,19 @@
 
 #include "CowString.h"
 #include "CowString_TextfileStatistics.h"
+#include "IncrementalWordFrequency.h"
+#include "WordFrequencyEngine.h"
 
 #include <cctype>          // std::toupper
 #include <cstddef>         // std::size_t
+#include <filesystem>      // std::filesystem::temp_directory_path
 #include <fstream>         // std::ifstream
 #include <print>           // std::println
 #include <queue>           // std::priority_queue
 #include <string>          // std::string
 #include <string_view>     // std::string_view
 #include <unordered_map>   // std::unordered_map
+#include <utility>         // std::as_const
 #include <vector>          // std::vector
 
 // c'tor
@@ -84,6 +88,7 @@ void TextfileStatistics::countWordFrequencies() {
         }
     }
     std::println("Done Creating Dictionary");
+    std::println("Words: {} (sizeof(std::string): {})", frequenciesMap.size(), sizeof(std::string));
 
     auto pos = std::max_element(
         frequenciesMap.begin(),
@@ -143,7 +148,7 @@ void TextfileStatistics::countWordFrequenciesCOW() {
             CowString cs{ &sv[begin], end - begin };
 
             // If it's an uppercase word, convert it
-            // Note: This CowString currently has the state 'owning',
+            // Note: This CowString currently has the state 'owning' (or it is a small string),
             // so a 'write' access does *not* copy the underling string
             if (std::isupper(cs[0])) {
                 cs[0] = std::tolower(cs[0]);
@@ -160,6 +165,16 @@ void TextfileStatistics::countWordFrequenciesCOW() {
     }
     std::println("Done Creating Dictionary");
 
+    // short words are stored inline (small string optimization) - no heap allocation at all
+    std::size_t smallWords{};
+    for (const auto& [word, frequency] : frequenciesMap) {
+        if (word.isSmall()) {
+            ++smallWords;
+        }
+    }
+    std::println("Words stored inline: {} of {} (sizeof(CowString): {})",
+        smallWords, frequenciesMap.size(), sizeof(CowString));
+
     auto pos = std::max_element(
         frequenciesMap.begin(),
         frequenciesMap.end(),
@@ -179,6 +194,206 @@ void TextfileStatistics::countWordFrequenciesCOW() {
     std::println("Done.");
 }
 
+void TextfileStatistics::countWordFrequenciesSlices() {
+
+    using namespace COWString;
+
+    if (m_fileName.empty()) {
+        std::println("No Filename specified!");
+        return;
+    }
+
+    std::ifstream file{ m_fileName.data(), std::ios::binary };
+    if (!file.good()) {
+        std::println("File not found!");
+        return;
+    }
+
+    std::println("File {}", m_fileName);
+    std::println("[CowString - Slices] Starting ...");
+
+    ScopedTimer watch{};
+
+    // the whole file in one CowString - the words are slices of it
+    // (read directly into the buffer of the CowString - a single copy of the file)
+    file.seekg(0, std::ios::end);
+    const auto size{ static_cast<std::size_t>(file.tellg()) };
+    file.seekg(0, std::ios::beg);
+
+    const CowString text{ CowString::createWith(size, [&](char* buffer) {
+        file.read(buffer, static_cast<std::streamsize>(size));
+    }) };
+    std::string_view sv{ text };
+
+    std::unordered_map<CowString, std::size_t> frequenciesMap;
+
+    // any byte, that isn't a letter, separates words
+    auto isLetter = [](char ch) {
+        return std::isalpha(static_cast<unsigned char>(ch)) != 0;
+    };
+
+    std::size_t tokens{};
+    std::size_t slices{};
+
+    std::size_t begin{};
+    std::size_t end{};
+
+    while (true) {
+
+        while (end != sv.size() && !isLetter(sv[end]))
+            ++end;
+
+        if (end == sv.size())
+            break;
+
+        begin = end;
+
+        while (end != sv.size() && isLetter(sv[end]))
+            ++end;
+
+        // no allocation: a short word is stored inline, a long one shares the buffer of 'text'
+        CowString cs{ text.substr(begin, end - begin) };
+
+        // If it's an uppercase word, convert it
+        // Note: a long word is a slice of the shared buffer, so the test has to be
+        // a read-only access - the 'write' access copies the word (and only the word)
+        if (!cs.empty() && std::isupper(std::as_const(cs)[0])) {
+            cs[0] = std::tolower(cs[0]);
+        }
+
+        ++tokens;
+        if (cs.isSlice()) {
+            ++slices;
+        }
+
+        // if word does not exist, it is automatically inserted with value 0
+        frequenciesMap[cs]++;
+    }
+    std::println("Done Creating Dictionary");
+    std::println("Words: {} - slices of the file (no allocation): {} of {} tokens", frequenciesMap.size(), slices, tokens);
+
+    auto pos = std::max_element(
+        frequenciesMap.begin(),
+        frequenciesMap.end(),
+        [](const auto& a, const auto& b) {
+            const auto& [word1, frequency1] = a;
+            const auto& [word2, frequency2] = b;
+            return frequency1 < frequency2;
+        }
+    );
+
+    if (pos != frequenciesMap.end())
+    {
+        const auto& [word, frequency] = *pos;
+        std::println("Largest frequency: {} - Word: {}", frequency, word);
+    }
+
+    std::println("Done.");
+}
+
+void TextfileStatistics::countWordFrequenciesParallel() {
+
+    using namespace WordFrequency;
+
+    if (m_fileName.empty()) {
+        std::println("No Filename specified!");
+        return;
+    }
+
+    std::ifstream file{ m_fileName.data() };
+    if (!file.good()) {
+        std::println("File not found!");
+        return;
+    }
+    file.close();
+
+    std::println("File {}", m_fileName);
+    std::println("[Memory-mapped, multi-threaded] Starting ...");
+
+    ScopedTimer watch{};
+
+    // the words are views into the mapped file, one map per thread
+    Engine engine{ m_fileName };
+    engine.count();
+
+    std::println("Done Creating Dictionary");
+    std::println("Words: {} - total: {}", engine.uniqueWords(), engine.totalWords());
+
+    auto top{ engine.topWords(1) };
+
+    if (!top.empty())
+    {
+        const auto& [word, frequency] = top.front();
+        std::println("Largest frequency: {} - Word: {}", frequency, word);
+    }
+
+    std::println("Done.");
+}
+
+void TextfileStatistics::countWordFrequenciesIncremental() {
+
+    using namespace WordFrequency;
+
+    if (m_fileName.empty()) {
+        std::println("No Filename specified!");
+        return;
+    }
+
+    std::ifstream file{ m_fileName.data() };
+    if (!file.good()) {
+        std::println("File not found!");
+        return;
+    }
+    file.close();
+
+    std::println("File {}", m_fileName);
+    std::println("[Incremental] Starting ...");
+
+    // the snapshot goes to the temporary directory (not next to the corpus) and is removed at the end:
+    // every run starts without a snapshot, so the timing compares with the other variants
+    const std::filesystem::path snapshot{
+        std::filesystem::temp_directory_path() / (std::filesystem::path{ m_fileName }.filename().string() + ".snapshot")
+    };
+
+    std::filesystem::remove(snapshot);
+
+    {
+        ScopedTimer watch{};
+
+        IncrementalCounter counter{ m_fileName, snapshot.string() };
+
+        const std::size_t parsed{ counter.update() };
+        counter.saveSnapshot();
+
+        std::println("Done Creating Dictionary");
+        std::println("Words: {} - total: {} - parsed {} bytes", counter.uniqueWords(), counter.totalWords(), parsed);
+
+        auto top{ counter.topWords(1) };
+
+        if (!top.empty())
+        {
+            const auto& [word, frequency] = top.front();
+            std::println("Largest frequency: {} - Word: {}", frequency, word);
+        }
+    }
+
+    // a second run resumes from the snapshot: only the bytes appended since then are parsed
+    {
+        ScopedTimer watch{};
+
+        IncrementalCounter counter{ m_fileName, snapshot.string() };
+
+        const bool resumed{ counter.loadSnapshot() };
+        const std::size_t parsed{ counter.update() };
+
+        std::println("Resumed from snapshot: {} - total: {} - parsed {} bytes", resumed, counter.totalWords(), parsed);
+    }
+
+    std::filesystem::remove(snapshot);
+
+    std::println("Done.");
+}
+
 void TextfileStatistics::computeMostFrequentWords() {
 
     if (m_fileName.empty()) {
@@ -307,7 +522,7 @@ void TextfileStatistics::computeMostFrequentWordsCOW() {
             CowString cs{ &sv[begin], end - begin };
 
             // If it's an uppercase word, convert it
-            // Note: This CowString currently has the state 'owning',
+            // Note: This CowString currently has the state 'owning' (or it is a small string),
             // so a 'write' access does *not* copy the underling string
             if (std::isupper(cs[0])) {
                 cs[0] = std::tolower(cs[0]);
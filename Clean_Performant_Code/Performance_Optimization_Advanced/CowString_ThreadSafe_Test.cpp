@@ -0,0 +1,297 @@
+// =====================================================================================
+// CowString_ThreadSafe_Test.cpp // Simple implementation of a COW string class
+// =====================================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "CowString.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace CowString_ThreadSafe_SimpleTest {
+
+    using namespace COWString;
+
+    static constexpr std::string_view Text{ "Lorem ipsum dolor sit amet, consectetur adipiscing elit" };
+
+    // copies of a string, that the main thread owns, are copied, modified and released by other threads
+    static void main_cow_string_thread_safe_01()
+    {
+        CowString original{ Text };
+
+        std::vector<std::thread> threads;
+        std::atomic<int> errors{};
+
+        for (int i{}; i != 4; ++i) {
+
+            threads.emplace_back([copy = original, i, &errors] () mutable {
+
+                CowString other{ copy };
+
+                copy[0] = static_cast<char>('0' + i);     // detaches 'copy'
+
+                if (copy[0] != '0' + i || other != CowString{ Text }) {
+                    ++errors;
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::println("original: {} - errors: {}", original, errors.load());
+    }
+
+    // producer / consumer: strings created by a thread outlive it,
+    // the consumer releases the last references
+    static void main_cow_string_thread_safe_02()
+    {
+        std::vector<CowString> words;
+
+        std::thread producer{ [&] () {
+
+            CowString word{ Text };
+            for (int i{}; i != 1'000; ++i) {
+                words.push_back(word);              // owner thread: biased count
+            }
+        } };
+
+        producer.join();
+
+        std::println("{} copies, shared: {}", words.size(), words.front() == words.back());
+
+        words.clear();                               // the owner thread has exited
+
+        std::println("Done.");
+    }
+}
+
+namespace CowString_ThreadSafe_StressTest {
+
+    using namespace COWString;
+
+#ifdef _DEBUG
+    static constexpr int Iterations = 10'000;        // debug
+#else
+    static constexpr int Iterations = 100'000;       // release
+#endif
+
+    static constexpr int NumThreads = 4;
+
+    // all threads copy and release the same strings, some copies are modified:
+    // no copy may ever see the modification of another one
+    static void main_cow_string_thread_safe_10()
+    {
+        std::println("Stress test: {} threads, {} iterations per thread", NumThreads, Iterations);
+
+        const CowString shared{ "This string is shared by all threads of the stress test" };
+
+        std::atomic<int> errors{};
+
+        auto worker = [&] () {
+
+            std::vector<CowString> copies;
+
+            for (int i{}; i != Iterations; ++i) {
+
+                copies.push_back(shared);
+
+                if (i % 7 == 0) {
+                    copies.back()[0] = '#';
+                }
+
+                if (copies.size() == 16) {
+
+                    for (const auto& copy : copies) {
+                        if (copy[0] != 'T' && copy[0] != '#') {
+                            ++errors;
+                        }
+                    }
+
+                    copies.erase(copies.begin(), copies.begin() + 8);
+                }
+
+                if (i % 1'000 == 0) {
+                    CowString::mergeQueuedReferences();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i{}; i != NumThreads; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::println("Errors: {} - shared: {}", errors.load(), shared);
+    }
+}
+
+namespace CowString_ThreadSafe_Benchmark {
+
+    using namespace COWString;
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 100;              // debug
+#else
+    static constexpr int Rounds = 1'000;            // release
+#endif
+
+    static constexpr std::size_t NumWords = 10'000;
+    static constexpr int NumThreads = 4;
+
+    // reference counted string with an always atomic reference count - for comparison
+    class AtomicCowString
+    {
+    private:
+        struct Controlblock
+        {
+            std::atomic<std::size_t> m_refCount;
+            std::size_t              m_length;
+        };
+
+        Controlblock* m_ptr;
+
+    public:
+        // c'tor/d'tor
+        explicit AtomicCowString(std::string_view sv)
+        {
+            void* mem{ ::operator new(sizeof(Controlblock) + sv.size() + 1) };
+            m_ptr = new (mem) Controlblock{ 1, sv.size() };
+            char* cp{ reinterpret_cast<char*>(m_ptr + 1) };
+            std::memcpy(cp, sv.data(), sv.size());
+            cp[sv.size()] = '\0';
+        }
+
+        ~AtomicCowString()
+        {
+            if (m_ptr->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                m_ptr->~Controlblock();
+                ::operator delete(m_ptr);
+            }
+        }
+
+        // copy only
+        AtomicCowString(const AtomicCowString& other) : m_ptr{ other.m_ptr }
+        {
+            m_ptr->m_refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        AtomicCowString& operator=(const AtomicCowString&) = delete;
+
+        std::size_t size() const { return m_ptr->m_length; }
+    };
+
+    // long words - short ones would be stored inline by CowString
+    template <typename TString>
+    static std::vector<TString> makeWords()
+    {
+        std::vector<TString> words;
+        words.reserve(NumWords);
+
+        for (std::size_t i{}; i != NumWords; ++i) {
+            std::string word{ "pneumonoultramicroscopicsilicovolcanoconiosis_" + std::to_string(i) };
+            words.emplace_back(std::string_view{ word });
+        }
+
+        return words;
+    }
+
+    // copy-heavy: all words are copied and released 'Rounds' times
+    template <typename TString>
+    static std::size_t copyWords(const std::vector<TString>& words)
+    {
+        std::vector<TString> copies;
+        copies.reserve(words.size());
+
+        std::size_t length{};
+
+        for (int round{}; round != Rounds; ++round) {
+
+            for (const auto& word : words) {
+                copies.push_back(word);
+            }
+
+            length += copies.back().size();
+            copies.clear();
+        }
+
+        return length;
+    }
+
+    template <typename TString>
+    static void singleThread(std::string_view name)
+    {
+        const std::vector<TString> words{ makeWords<TString>() };
+
+        std::println("{}:", name);
+        ScopedTimer watch{};
+        [[maybe_unused]] volatile std::size_t length{ copyWords(words) };
+    }
+
+    // the words are created by the main thread, all threads copy them
+    // (the main thread as owner thread, the others as non-owner threads)
+    template <typename TString>
+    static void crossThread(std::string_view name)
+    {
+        const std::vector<TString> words{ makeWords<TString>() };
+
+        std::println("{}:", name);
+        ScopedTimer watch{};
+
+        std::vector<std::thread> threads;
+        for (int i{}; i != NumThreads - 1; ++i) {
+            threads.emplace_back([&] () { [[maybe_unused]] volatile std::size_t length{ copyWords(words) }; });
+        }
+
+        [[maybe_unused]] volatile std::size_t length{ copyWords(words) };
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    static void main_cow_string_thread_safe_20()
+    {
+        std::println("Single thread: {} words copied {} times", NumWords, Rounds);
+
+        singleThread<std::string>("std::string");
+        singleThread<CowString>("CowString (biased reference count)");
+        singleThread<AtomicCowString>("CowString (atomic reference count)");
+
+        std::println();
+        std::println("{} threads: {} words copied {} times per thread", NumThreads, NumWords, Rounds);
+
+        crossThread<std::string>("std::string");
+        crossThread<CowString>("CowString (biased reference count)");
+        crossThread<AtomicCowString>("CowString (atomic reference count)");
+    }
+}
+
+void main_cow_string_thread_safe()
+{
+    CowString_ThreadSafe_SimpleTest::main_cow_string_thread_safe_01();
+    CowString_ThreadSafe_SimpleTest::main_cow_string_thread_safe_02();
+
+    CowString_ThreadSafe_StressTest::main_cow_string_thread_safe_10();
+
+    CowString_ThreadSafe_Benchmark::main_cow_string_thread_safe_20();
+}
+
+// =====================================================================================
+// End-of-File
+// =====================================================================================
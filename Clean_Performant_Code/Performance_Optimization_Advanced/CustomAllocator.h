@@ -4,9 +4,16 @@
 
 #pragma once
 
+#include <cstdlib>
+#include <limits>
 #include <memory>
+#include <new>
 #include <print>
 
+// tracing output of all CustomAllocator instances,
+// benchmarks switch it off to measure the allocator itself
+inline bool CustomAllocatorTracing{ true };
+
 template<typename T>
 class CustomAllocator {
 public:
@@ -23,7 +30,9 @@ public:
     {
         size_t numBytes{ n * sizeof(T) };
 
-        std::println("Allocating {} bytes", numBytes);
+        if (CustomAllocatorTracing) {
+            std::println("Allocating {} bytes", numBytes);
+        }
 
         if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
             throw std::bad_array_new_length();
@@ -38,21 +47,27 @@ public:
 
     void deallocate(T* p, std::size_t) noexcept
     {
-        std::println("Deallocating memory");
+        if (CustomAllocatorTracing) {
+            std::println("Deallocating memory");
+        }
         std::free(p);
     }
 
     template<typename U, typename... TArgs>
     void construct(U* p, TArgs&&... args)
     {
-        std::println("Constructing element");
+        if (CustomAllocatorTracing) {
+            std::println("Constructing element");
+        }
         new(p) U{ std::forward<TArgs>(args)... };
     }
 
     template<typename U>
     void destroy(U* p) noexcept
     {
-        std::println("Destroying element");
+        if (CustomAllocatorTracing) {
+            std::println("Destroying element");
+        }
         p->~U();
     }
 
@@ -0,0 +1,98 @@
+// ===========================================================================
+// HeavyHitters.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace HeavyHitters {
+
+    // Space-Saving (Metwally, Agrawal, El Abbadi): approximate top-K of a stream
+    // in fixed memory - 'capacity' counters, independent of the number of distinct items.
+    //
+    //  * A monitored item increments its counter.
+    //  * An unmonitored item replaces the item with the minimum count 'min':
+    //    its counter becomes 'min + 1', its error 'min' (it might have occurred 'min' times).
+    //
+    // Guarantees, with N the total count of the stream:
+    //
+    //  * count - error <= true count <= count
+    //  * error <= min <= N / capacity
+    //  * each item occurring more than N / capacity times is monitored
+    //
+    // The counters are kept in a min-heap (the minimum is found in O(1), an
+    // increment costs O(log capacity)), the items are found with a hash index.
+    // Once all counters are in use, a replacement reuses the string of the old item
+    // and the node of the index - no allocation.
+    //
+    // Summaries of parts of a stream (e.g. one per thread) can be merged.
+
+    struct Item
+    {
+        std::string   m_item;
+        std::size_t   m_count;        // upper bound of the true count
+        std::size_t   m_error;        // count - error: lower bound of the true count
+        bool          m_guaranteed;   // the item is in the top-K for sure
+    };
+
+    class SpaceSaving
+    {
+    private:
+        struct Counter
+        {
+            std::string   m_item;
+            std::size_t   m_count;
+            std::size_t   m_error;
+            std::uint32_t m_heapPos;
+        };
+
+    public:
+        // c'tor
+        explicit SpaceSaving(std::size_t capacity);
+
+        // copy: the index refers to the strings of the counters - it has to be rebuilt
+        SpaceSaving(const SpaceSaving& other);
+        SpaceSaving& operator=(const SpaceSaving& other);
+        SpaceSaving(SpaceSaving&&) noexcept = default;
+        SpaceSaving& operator=(SpaceSaving&&) noexcept = default;
+
+        // public interface
+        void add(std::string_view item, std::size_t count = 1);
+
+        // combines the summary of another part of the stream into this one
+        void merge(const SpaceSaving& other);
+
+        // the (at most) k items with the largest counts, in descending order
+        std::vector<Item> topK(std::size_t k) const;
+
+        // getter
+        std::size_t capacity() const { return m_capacity; }
+        std::size_t size() const { return m_counters.size(); }
+        std::size_t total() const { return m_total; }
+
+        // no unmonitored item occurred more often than this
+        std::size_t maxError() const;
+
+    private:
+        void siftDown(std::size_t pos);
+        void swapHeap(std::size_t pos1, std::size_t pos2);
+        void rebuildIndex();
+
+        // member data
+        std::size_t                                            m_capacity;
+        std::size_t                                            m_total;
+        std::vector<Counter>                                   m_counters;
+        std::vector<std::uint32_t>                             m_heap;      // indices of the counters, min-heap by count
+        std::unordered_map<std::string_view, std::uint32_t>    m_index;     // the keys refer to the strings of the counters
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
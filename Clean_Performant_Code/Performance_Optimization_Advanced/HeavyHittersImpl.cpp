@@ -0,0 +1,244 @@
+// ===========================================================================
+// HeavyHittersImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "HeavyHitters.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace HeavyHitters {
+
+    // =======================================================================
+    // c'tors
+
+    SpaceSaving::SpaceSaving(std::size_t capacity)
+        : m_capacity{ capacity }, m_total{}
+    {
+        if (capacity == 0) {
+            throw std::invalid_argument{ "SpaceSaving: capacity must not be zero" };
+        }
+
+        // the counters must never move: the index refers to their strings
+        m_counters.reserve(capacity);
+        m_heap.reserve(capacity);
+        m_index.reserve(capacity);
+    }
+
+    SpaceSaving::SpaceSaving(const SpaceSaving& other)
+        : m_capacity{ other.m_capacity }, m_total{ other.m_total }, m_heap{ other.m_heap }
+    {
+        m_counters.reserve(m_capacity);
+        m_counters = other.m_counters;
+        rebuildIndex();
+    }
+
+    SpaceSaving& SpaceSaving::operator=(const SpaceSaving& other)
+    {
+        if (this != &other) {
+            SpaceSaving tmp{ other };
+            *this = std::move(tmp);
+        }
+
+        return *this;
+    }
+
+    // =======================================================================
+    // public interface
+
+    void SpaceSaving::add(std::string_view item, std::size_t count)
+    {
+        m_total += count;
+
+        // monitored item
+        if (auto pos{ m_index.find(item) }; pos != m_index.end()) {
+            Counter& counter{ m_counters[pos->second] };
+            counter.m_count += count;
+            siftDown(counter.m_heapPos);
+            return;
+        }
+
+        // a free counter
+        if (m_counters.size() < m_capacity) {
+
+            const auto index{ static_cast<std::uint32_t>(m_counters.size()) };
+
+            m_counters.push_back(Counter{ std::string{ item }, count, 0, index });
+            m_heap.push_back(index);
+            m_index.emplace(m_counters.back().m_item, index);
+
+            // sift up
+            for (std::size_t heapPos{ index }; heapPos != 0; ) {
+
+                const std::size_t parent{ (heapPos - 1) / 2 };
+
+                if (m_counters[m_heap[parent]].m_count <= m_counters[m_heap[heapPos]].m_count) {
+                    break;
+                }
+
+                swapHeap(parent, heapPos);
+                heapPos = parent;
+            }
+
+            return;
+        }
+
+        // replace the item with the minimum count - it keeps its node in the index
+        Counter& counter{ m_counters[m_heap[0]] };
+
+        auto node{ m_index.extract(counter.m_item) };
+
+        counter.m_error = counter.m_count;
+        counter.m_count += count;
+        counter.m_item.assign(item);
+
+        node.key() = counter.m_item;
+        m_index.insert(std::move(node));
+
+        siftDown(0);
+    }
+
+    void SpaceSaving::merge(const SpaceSaving& other)
+    {
+        // an item missing in a full summary may have occurred up to its minimum count
+        const std::size_t min1{ maxError() };
+        const std::size_t min2{ other.maxError() };
+
+        std::vector<Counter> combined;
+        combined.reserve(m_counters.size() + other.m_counters.size());
+
+        for (const Counter& counter : m_counters) {
+
+            Counter merged{ counter.m_item, counter.m_count + min2, counter.m_error + min2, 0 };
+
+            if (auto pos{ other.m_index.find(counter.m_item) }; pos != other.m_index.end()) {
+                merged.m_count = counter.m_count + other.m_counters[pos->second].m_count;
+                merged.m_error = counter.m_error + other.m_counters[pos->second].m_error;
+            }
+
+            combined.push_back(std::move(merged));
+        }
+
+        for (const Counter& counter : other.m_counters) {
+            if (!m_index.contains(counter.m_item)) {
+                combined.push_back(Counter{ counter.m_item, counter.m_count + min1, counter.m_error + min1, 0 });
+            }
+        }
+
+        // keep the 'capacity' largest counts
+        if (combined.size() > m_capacity) {
+            std::nth_element(combined.begin(), combined.begin() + m_capacity, combined.end(),
+                [] (const Counter& a, const Counter& b) { return a.m_count > b.m_count; }
+            );
+            combined.resize(m_capacity);
+        }
+
+        m_total += other.m_total;
+
+        m_counters.clear();
+        for (Counter& counter : combined) {
+            m_counters.push_back(std::move(counter));
+        }
+
+        m_heap.resize(m_counters.size());
+        for (std::size_t i{}; i != m_counters.size(); ++i) {
+            m_heap[i] = static_cast<std::uint32_t>(i);
+            m_counters[i].m_heapPos = static_cast<std::uint32_t>(i);
+        }
+
+        for (std::size_t pos{ m_heap.size() / 2 }; pos-- != 0; ) {
+            siftDown(pos);
+        }
+
+        rebuildIndex();
+    }
+
+    std::vector<Item> SpaceSaving::topK(std::size_t k) const
+    {
+        std::vector<const Counter*> sorted;
+        sorted.reserve(m_counters.size());
+
+        for (const Counter& counter : m_counters) {
+            sorted.push_back(&counter);
+        }
+
+        std::sort(sorted.begin(), sorted.end(),
+            [] (const Counter* a, const Counter* b) { return a->m_count > b->m_count; }
+        );
+
+        k = std::min(k, sorted.size());
+
+        // an item is in the top-K for sure, if its lower bound reaches
+        // the upper bound of every item behind position k
+        const std::size_t threshold{ (k < sorted.size()) ? sorted[k]->m_count : maxError() };
+
+        std::vector<Item> result;
+        result.reserve(k);
+
+        for (std::size_t i{}; i != k; ++i) {
+            const Counter& counter{ *sorted[i] };
+            result.push_back(Item{ counter.m_item, counter.m_count, counter.m_error, counter.m_count - counter.m_error >= threshold });
+        }
+
+        return result;
+    }
+
+    std::size_t SpaceSaving::maxError() const
+    {
+        // as long as a counter is free, no item has been evicted
+        return (m_counters.size() < m_capacity) ? 0 : m_counters[m_heap[0]].m_count;
+    }
+
+    // =======================================================================
+    // min-heap
+
+    void SpaceSaving::siftDown(std::size_t pos)
+    {
+        const std::size_t size{ m_heap.size() };
+
+        while (true) {
+
+            const std::size_t left{ 2 * pos + 1 };
+            const std::size_t right{ left + 1 };
+
+            std::size_t smallest{ pos };
+
+            if (left < size && m_counters[m_heap[left]].m_count < m_counters[m_heap[smallest]].m_count) {
+                smallest = left;
+            }
+
+            if (right < size && m_counters[m_heap[right]].m_count < m_counters[m_heap[smallest]].m_count) {
+                smallest = right;
+            }
+
+            if (smallest == pos) {
+                return;
+            }
+
+            swapHeap(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    void SpaceSaving::swapHeap(std::size_t pos1, std::size_t pos2)
+    {
+        std::swap(m_heap[pos1], m_heap[pos2]);
+        m_counters[m_heap[pos1]].m_heapPos = static_cast<std::uint32_t>(pos1);
+        m_counters[m_heap[pos2]].m_heapPos = static_cast<std::uint32_t>(pos2);
+    }
+
+    void SpaceSaving::rebuildIndex()
+    {
+        m_index.clear();
+        m_index.reserve(m_capacity);
+
+        for (std::size_t i{}; i != m_counters.size(); ++i) {
+            m_index.emplace(m_counters[i].m_item, static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
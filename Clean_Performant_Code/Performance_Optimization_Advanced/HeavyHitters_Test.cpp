@@ -0,0 +1,188 @@
+// ===========================================================================
+// HeavyHitters_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "HeavyHitters.h"
+
+#include <cstddef>
+#include <format>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace HeavyHitters_SimpleTest {
+
+    using namespace HeavyHitters;
+
+    static void printTopK(const SpaceSaving& summary, std::size_t k)
+    {
+        std::println("N = {}, {} counters, max. error: {}", summary.total(), summary.capacity(), summary.maxError());
+
+        for (const auto& [item, count, error, guaranteed] : summary.topK(k)) {
+            std::println("  {:<28} {:>8} (>= {:>8}) {}", item, count, count - error, guaranteed ? "guaranteed" : "");
+        }
+    }
+
+    static void main_heavy_hitters_01()
+    {
+        SpaceSaving summary{ 4 };
+
+        for (std::string_view item : { "a", "b", "a", "c", "d", "a", "e", "b", "a", "f", "a", "b" }) {
+            summary.add(item);
+        }
+
+        printTopK(summary, 3);
+    }
+
+    // a log stream: a few frequent messages, one request id per line (unbounded cardinality)
+    static std::vector<std::string> makeLogStream(std::size_t lines)
+    {
+        static constexpr std::string_view Messages[]{
+            "GET /index.html", "GET /api/users", "POST /api/login", "GET /favicon.ico", "DELETE /api/session", "PUT /api/users"
+        };
+
+        std::mt19937 generator{ 4711 };
+        std::discrete_distribution<int> messageDistribution{ 40, 25, 15, 10, 5, 5 };
+
+        std::vector<std::string> stream;
+        stream.reserve(2 * lines);
+
+        for (std::size_t i{}; i != lines; ++i) {
+            stream.emplace_back(Messages[messageDistribution(generator)]);
+            stream.push_back(std::format("req-{:016x}", generator()));
+        }
+
+        return stream;
+    }
+
+    static bool checkBounds(const SpaceSaving& summary, const std::vector<std::string>& stream, std::size_t k)
+    {
+        std::unordered_map<std::string_view, std::size_t> exact;
+        for (const std::string& item : stream) {
+            ++exact[item];
+        }
+
+        bool ok{ true };
+        for (const auto& [item, count, error, guaranteed] : summary.topK(k)) {
+            const std::size_t trueCount{ exact[item] };
+            ok = ok && count - error <= trueCount && trueCount <= count;
+        }
+
+        std::println("Exact map: {} entries - Space-Saving: {} counters - error bounds hold: {}", exact.size(), summary.size(), ok);
+        return ok;
+    }
+
+    static void main_heavy_hitters_02()
+    {
+        const std::vector<std::string> stream{ makeLogStream(1'000'000) };
+
+        SpaceSaving summary{ 64 };
+
+        for (const std::string& item : stream) {
+            summary.add(item);
+        }
+
+        printTopK(summary, 6);
+        checkBounds(summary, stream, 6);
+    }
+
+    // one summary per thread, merged
+    static void main_heavy_hitters_03()
+    {
+        const std::vector<std::string> stream{ makeLogStream(1'000'000) };
+
+        constexpr std::size_t NumThreads{ 4 };
+
+        std::vector<SpaceSaving> summaries(NumThreads, SpaceSaving{ 64 });
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t t{}; t != NumThreads; ++t) {
+                threads.emplace_back([&, t] () {
+                    const std::size_t begin{ stream.size() * t / NumThreads };
+                    const std::size_t end{ stream.size() * (t + 1) / NumThreads };
+                    for (std::size_t i{ begin }; i != end; ++i) {
+                        summaries[t].add(stream[i]);
+                    }
+                });
+            }
+        }
+
+        for (std::size_t t{ 1 }; t != NumThreads; ++t) {
+            summaries[0].merge(summaries[t]);
+        }
+
+        std::println("Merged summary of {} threads:", NumThreads);
+        printTopK(summaries[0], 6);
+        checkBounds(summaries[0], stream, 6);
+    }
+}
+
+namespace HeavyHitters_Benchmark {
+
+    using namespace HeavyHitters;
+
+#ifdef _DEBUG
+    static constexpr std::size_t Items = 200'000;        // debug
+#else
+    static constexpr std::size_t Items = 5'000'000;      // release
+#endif
+
+    // high cardinality: every second item is unique
+    static void main_heavy_hitters_20()
+    {
+        std::mt19937_64 generator{ 4711 };
+        std::vector<std::string> items;
+        items.reserve(Items);
+
+        for (std::size_t i{}; i != Items; ++i) {
+            items.push_back((i % 2 == 0) ? std::format("token-{}", generator() % 100) : std::format("id-{:016x}", generator()));
+        }
+
+        std::println("{} items", Items);
+
+        std::println("std::unordered_map (exact):");
+        {
+            ScopedTimer watch{};
+
+            std::unordered_map<std::string_view, std::size_t> exact;
+            for (const std::string& item : items) {
+                ++exact[item];
+            }
+
+            std::println("{} entries", exact.size());
+        }
+
+        std::println("Space-Saving, 1000 counters:");
+        {
+            ScopedTimer watch{};
+
+            SpaceSaving summary{ 1'000 };
+            for (const std::string& item : items) {
+                summary.add(item);
+            }
+
+            std::println("{} counters - max. error {}", summary.size(), summary.maxError());
+        }
+    }
+}
+
+void main_heavy_hitters()
+{
+    HeavyHitters_SimpleTest::main_heavy_hitters_01();
+    HeavyHitters_SimpleTest::main_heavy_hitters_02();
+    HeavyHitters_SimpleTest::main_heavy_hitters_03();
+
+    HeavyHitters_Benchmark::main_heavy_hitters_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,95 @@
+// ===========================================================================
+// IncrementalWordFrequency.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace WordFrequency {
+
+    // Incremental word frequencies of an append-only file (e.g. a log file):
+    //
+    //  * The counts and the number of bytes processed so far are persisted
+    //    in a snapshot file (checkpoint).
+    //  * 'update' parses only the bytes appended since the last update.
+    //    A word at the end of the file might still be written - it is left
+    //    for the next update, the offset stops in front of it.
+    //  * A file, which became shorter or whose beginning changed
+    //    (truncated or rotated), is counted again from the start.
+    //  * 'follow' waits for appended data (inotify on Linux, polling otherwise)
+    //    and updates the counts.
+    //
+    // Words are runs of ASCII letters, an uppercase first letter is folded to lowercase.
+
+    class IncrementalCounter
+    {
+    private:
+        // heterogeneous lookup: words are looked up by std::string_view
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view sv) const noexcept {
+                return std::hash<std::string_view>{}(sv);
+            }
+        };
+
+        using CountMap = std::unordered_map<std::string, std::size_t, StringHash, std::equal_to<>>;
+
+        static constexpr std::size_t ChunkSize{ 1024 * 1024 };
+        static constexpr std::size_t PrefixSize{ 4096 };         // identifies the file
+
+    public:
+        // c'tor
+        IncrementalCounter(std::string_view fileName, std::string_view snapshotName);
+
+        // checkpoint - 'loadSnapshot' returns false, if there is no (valid) snapshot
+        bool loadSnapshot();
+        void saveSnapshot() const;
+
+        // parses the appended bytes - returns their number
+        std::size_t update();
+
+        // updates on each change of the file, until a stop is requested,
+        // 'onUpdate' is called after each update with new bytes
+        void follow(std::stop_token token, const std::function<void(const IncrementalCounter&)>& onUpdate,
+            std::chrono::milliseconds interval = std::chrono::milliseconds{ 200 });
+
+        void reset();
+
+        // getter
+        std::uint64_t offset() const { return m_offset; }
+        std::size_t totalWords() const { return m_totalWords; }
+        std::size_t uniqueWords() const { return m_counts.size(); }
+
+        std::size_t countOf(std::string_view word) const;
+        std::vector<std::pair<std::string, std::size_t>> topWords(std::size_t k) const;
+
+    private:
+        void countWords(std::string_view text);
+        std::uint64_t prefixHash(std::uint64_t length) const;
+
+        // member data
+        std::string      m_fileName;
+        std::string      m_snapshotName;
+        CountMap         m_counts;
+        std::uint64_t    m_offset;         // bytes processed
+        std::uint64_t    m_prefixHash;     // hash of the first 'PrefixSize' bytes (or less, if the file is shorter)
+        std::uint64_t    m_prefixLength;
+        std::size_t      m_totalWords;
+        std::string      m_buffer;
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,330 @@
+// ===========================================================================
+// IncrementalWordFrequencyImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "IncrementalWordFrequency.h"
+#include "SimdTokenizer.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace WordFrequency {
+
+    static constexpr std::array<char, 8> SnapshotMagic{ 'W', 'F', 'S', 'N', 'A', 'P', '0', '1' };
+
+    static bool isLetter(char ch)
+    {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+    }
+
+    // =======================================================================
+    // c'tor
+
+    IncrementalCounter::IncrementalCounter(std::string_view fileName, std::string_view snapshotName)
+        : m_fileName{ fileName }, m_snapshotName{ snapshotName }, m_counts{},
+          m_offset{}, m_prefixHash{}, m_prefixLength{}, m_totalWords{}, m_buffer{}
+    {
+    }
+
+    void IncrementalCounter::reset()
+    {
+        m_counts.clear();
+        m_offset = 0;
+        m_prefixHash = 0;
+        m_prefixLength = 0;
+        m_totalWords = 0;
+    }
+
+    // =======================================================================
+    // checkpoint
+    //
+    // Format (native byte order):
+    //   magic, offset, prefix length, prefix hash, total words, number of entries,
+    //   per entry: length of the word (32 bit), the word, its count (64 bit)
+
+    template <typename T>
+    static void writeValue(std::ofstream& out, T value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    static bool readValue(std::ifstream& in, T& value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    void IncrementalCounter::saveSnapshot() const
+    {
+        // write a temporary file and rename it: a crash never leaves a half written snapshot
+        const std::string tmpName{ m_snapshotName + ".tmp" };
+
+        {
+            std::ofstream out{ tmpName, std::ios::binary | std::ios::trunc };
+            if (!out) {
+                throw std::runtime_error{ "Unable to write snapshot " + tmpName };
+            }
+
+            out.write(SnapshotMagic.data(), SnapshotMagic.size());
+            writeValue<std::uint64_t>(out, m_offset);
+            writeValue<std::uint64_t>(out, m_prefixLength);
+            writeValue<std::uint64_t>(out, m_prefixHash);
+            writeValue<std::uint64_t>(out, m_totalWords);
+            writeValue<std::uint64_t>(out, m_counts.size());
+
+            for (const auto& [word, count] : m_counts) {
+                writeValue<std::uint32_t>(out, static_cast<std::uint32_t>(word.size()));
+                out.write(word.data(), static_cast<std::streamsize>(word.size()));
+                writeValue<std::uint64_t>(out, count);
+            }
+
+            if (!out.flush()) {
+                throw std::runtime_error{ "Unable to write snapshot " + tmpName };
+            }
+        }
+
+        std::filesystem::rename(tmpName, m_snapshotName);
+    }
+
+    bool IncrementalCounter::loadSnapshot()
+    {
+        reset();
+
+        std::ifstream in{ m_snapshotName, std::ios::binary };
+        if (!in) {
+            return false;
+        }
+
+        std::array<char, SnapshotMagic.size()> magic{};
+        in.read(magic.data(), magic.size());
+
+        std::uint64_t offset{}, prefixLength{}, prefixHash{}, totalWords{}, entries{};
+
+        if (!in || magic != SnapshotMagic ||
+            !readValue(in, offset) || !readValue(in, prefixLength) || !readValue(in, prefixHash) ||
+            !readValue(in, totalWords) || !readValue(in, entries))
+        {
+            return false;
+        }
+
+        m_counts.reserve(entries);
+
+        std::string word;
+
+        for (std::uint64_t i{}; i != entries; ++i) {
+
+            std::uint32_t length{};
+            std::uint64_t count{};
+
+            if (!readValue(in, length)) {
+                reset();
+                return false;
+            }
+
+            word.resize(length);
+
+            if (!in.read(word.data(), length) || !readValue(in, count)) {
+                reset();
+                return false;
+            }
+
+            m_counts.emplace(word, count);
+        }
+
+        m_offset = offset;
+        m_prefixLength = prefixLength;
+        m_prefixHash = prefixHash;
+        m_totalWords = totalWords;
+
+        return true;
+    }
+
+    // =======================================================================
+    // public interface
+
+    std::size_t IncrementalCounter::update()
+    {
+        std::error_code error{};
+        const std::uint64_t size{ std::filesystem::file_size(m_fileName, error) };
+        if (error) {
+            return 0;
+        }
+
+        // truncated or rotated: start again
+        if (size < m_offset || (m_prefixLength != 0 && prefixHash(m_prefixLength) != m_prefixHash)) {
+            reset();
+        }
+
+        if (size == m_offset) {
+            return 0;
+        }
+
+        std::ifstream file{ m_fileName, std::ios::binary };
+        if (!file) {
+            return 0;
+        }
+
+        file.seekg(static_cast<std::streamoff>(m_offset));
+
+        const std::uint64_t start{ m_offset };
+
+        m_buffer.clear();
+
+        for (std::uint64_t pos{ m_offset }; pos < size; ) {
+
+            // the unprocessed rest of the previous chunk is kept in front
+            const std::size_t pending{ m_buffer.size() };
+            const auto length{ static_cast<std::size_t>(std::min<std::uint64_t>(ChunkSize, size - pos)) };
+
+            m_buffer.resize(pending + length);
+            if (!file.read(m_buffer.data() + pending, static_cast<std::streamsize>(length))) {
+                m_buffer.resize(pending + static_cast<std::size_t>(file.gcount()));
+                break;
+            }
+
+            pos += length;
+
+            // process up to the last separator - the word behind it may continue in the next chunk
+            auto last{ std::find_if_not(m_buffer.rbegin(), m_buffer.rend(), isLetter) };
+            const auto end{ static_cast<std::size_t>(m_buffer.rend() - last) };
+
+            countWords(std::string_view{ m_buffer.data(), end });
+
+            m_offset += end;
+            m_buffer.erase(0, end);
+        }
+
+        // a word at the end of the file stays for the next update
+        m_buffer.clear();
+
+        if (m_prefixLength < PrefixSize && m_offset > m_prefixLength) {
+            m_prefixLength = std::min<std::uint64_t>(PrefixSize, m_offset);
+            m_prefixHash = prefixHash(m_prefixLength);
+        }
+
+        return static_cast<std::size_t>(m_offset - start);
+    }
+
+    void IncrementalCounter::follow(std::stop_token token, const std::function<void(const IncrementalCounter&)>& onUpdate,
+        std::chrono::milliseconds interval)
+    {
+#if defined(__linux__)
+        // wakes up on a change of the file, at the latest after 'interval' (to check for a stop request)
+        const int fd{ ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC) };
+        const int watch{ (fd < 0) ? -1 : ::inotify_add_watch(fd, m_fileName.c_str(), IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF) };
+
+        while (!token.stop_requested()) {
+
+            if (update() != 0) {
+                onUpdate(*this);
+            }
+
+            if (watch < 0) {
+                std::this_thread::sleep_for(interval);
+                continue;
+            }
+
+            ::pollfd request{ fd, POLLIN, 0 };
+
+            if (::poll(&request, 1, static_cast<int>(interval.count())) > 0) {
+                // the events themselves don't matter - drain them
+                alignas(inotify_event) char events[4096];
+                while (::read(fd, events, sizeof(events)) > 0) {
+                }
+            }
+        }
+
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#else
+        while (!token.stop_requested()) {
+
+            if (update() != 0) {
+                onUpdate(*this);
+            }
+
+            std::this_thread::sleep_for(interval);
+        }
+#endif
+    }
+
+    std::size_t IncrementalCounter::countOf(std::string_view word) const
+    {
+        auto pos{ m_counts.find(word) };
+        return (pos == m_counts.end()) ? 0 : pos->second;
+    }
+
+    std::vector<std::pair<std::string, std::size_t>> IncrementalCounter::topWords(std::size_t k) const
+    {
+        std::vector<std::pair<std::string, std::size_t>> entries{ m_counts.begin(), m_counts.end() };
+
+        k = std::min(k, entries.size());
+
+        std::partial_sort(entries.begin(), entries.begin() + k, entries.end(),
+            [] (const auto& a, const auto& b) { return a.second > b.second; }
+        );
+
+        entries.resize(k);
+        return entries;
+    }
+
+    // =======================================================================
+    // helper
+
+    void IncrementalCounter::countWords(std::string_view text)
+    {
+        std::string folded;
+
+        SimdTokenizer::forEachWord(text, [&] (std::string_view word) {
+
+            if (word[0] >= 'A' && word[0] <= 'Z') {
+                folded.assign(word);
+                folded[0] = static_cast<char>(folded[0] - 'A' + 'a');
+                word = folded;
+            }
+
+            if (auto pos{ m_counts.find(word) }; pos != m_counts.end()) {
+                ++pos->second;
+            }
+            else {
+                m_counts.emplace(word, 1);
+            }
+
+            ++m_totalWords;
+        });
+    }
+
+    // FNV-1a of the first 'length' bytes of the file
+    std::uint64_t IncrementalCounter::prefixHash(std::uint64_t length) const
+    {
+        std::ifstream file{ m_fileName, std::ios::binary };
+
+        std::array<char, PrefixSize> prefix{};
+        file.read(prefix.data(), static_cast<std::streamsize>(std::min<std::uint64_t>(length, PrefixSize)));
+
+        std::uint64_t hash{ 14695981039346656037ull };
+
+        for (std::streamsize i{}; i != file.gcount(); ++i) {
+            hash = (hash ^ static_cast<unsigned char>(prefix[i])) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,185 @@
+// ===========================================================================
+// IncrementalWordFrequency_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "IncrementalWordFrequency.h"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace IncrementalWordFrequency_SimpleTest {
+
+    using namespace WordFrequency;
+
+    static const std::string LogName{ (std::filesystem::temp_directory_path() / "incremental_words.log").string() };
+    static const std::string SnapshotName{ (std::filesystem::temp_directory_path() / "incremental_words.snap").string() };
+
+    static void append(std::string_view text)
+    {
+        std::ofstream log{ LogName, std::ios::binary | std::ios::app };
+        log << text;
+    }
+
+    static void main_incremental_word_frequency_01()
+    {
+        std::filesystem::remove(LogName);
+        std::filesystem::remove(SnapshotName);
+
+        append("Lorem ipsum dolor sit amet\n");
+
+        {
+            IncrementalCounter counter{ LogName, SnapshotName };
+            const bool loaded{ counter.loadSnapshot() };
+            std::println("Snapshot loaded: {}", loaded);
+
+            const std::size_t parsed{ counter.update() };
+            std::println("Parsed {} bytes - words: {}", parsed, counter.totalWords());
+            counter.saveSnapshot();
+        }
+
+        // an unfinished word at the end of the file is counted with the next update
+        append("lorem ipsum dol");
+
+        {
+            IncrementalCounter counter{ LogName, SnapshotName };
+            const bool loaded{ counter.loadSnapshot() };
+            std::println("Snapshot loaded: {} - offset {}", loaded, counter.offset());
+
+            std::size_t parsed{ counter.update() };
+            std::println("Parsed {} bytes - words: {}", parsed, counter.totalWords());
+
+            append("or\n");
+            parsed = counter.update();
+            std::println("Parsed {} bytes - words: {} - 'dolor': {}", parsed, counter.totalWords(), counter.countOf("dolor"));
+            counter.saveSnapshot();
+        }
+
+        // rotated: a new file with the same name
+        std::filesystem::remove(LogName);
+        append("Consectetur adipiscing elit\n");
+
+        {
+            IncrementalCounter counter{ LogName, SnapshotName };
+            const bool loaded{ counter.loadSnapshot() };
+            std::println("Snapshot loaded: {} - offset {}", loaded, counter.offset());
+
+            const std::size_t parsed{ counter.update() };
+            std::println("Parsed {} bytes - words: {} - 'lorem': {}", parsed, counter.totalWords(), counter.countOf("lorem"));
+        }
+    }
+
+    // follow mode: a writer appends lines, the counter follows the file
+    static void main_incremental_word_frequency_02()
+    {
+        std::filesystem::remove(LogName);
+        append("");
+
+        IncrementalCounter counter{ LogName, SnapshotName };
+
+        std::jthread follower{ [&] (std::stop_token token) {
+            counter.follow(token, [] (const IncrementalCounter& counter) {
+                std::println("  update: offset {:>4} - words {:>3}", counter.offset(), counter.totalWords());
+            }, std::chrono::milliseconds{ 50 });
+        } };
+
+        for (int i{}; i != 5; ++i) {
+            append("Lorem ipsum dolor sit amet, consectetur adipiscing elit\n");
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 100 });
+        }
+
+        follower.request_stop();
+        follower.join();
+
+        std::println("Followed: {} words", counter.totalWords());
+
+        std::filesystem::remove(LogName);
+        std::filesystem::remove(SnapshotName);
+    }
+}
+
+namespace IncrementalWordFrequency_Benchmark {
+
+    using namespace WordFrequency;
+
+#ifdef _DEBUG
+    static constexpr int Copies = 2;         // debug
+#else
+    static constexpr int Copies = 20;        // release
+#endif
+
+    // a growing file: a full recount vs. an update from the snapshot
+    static void main_incremental_word_frequency_20()
+    {
+        const std::string logName{ (std::filesystem::temp_directory_path() / "incremental_bench.log").string() };
+        const std::string snapshotName{ (std::filesystem::temp_directory_path() / "incremental_bench.snap").string() };
+
+        std::ifstream source{ "LoremIpsumHuge.txt", std::ios::binary };
+        const std::string text{ std::istreambuf_iterator<char>{ source }, std::istreambuf_iterator<char>{} };
+
+        {
+            std::ofstream log{ logName, std::ios::binary | std::ios::trunc };
+            for (int i{}; i != Copies; ++i) {
+                log << text;
+            }
+        }
+
+        std::filesystem::remove(snapshotName);
+
+        {
+            IncrementalCounter counter{ logName, snapshotName };
+            counter.update();
+            counter.saveSnapshot();
+        }
+
+        // 1 percent appended
+        {
+            std::ofstream log{ logName, std::ios::binary | std::ios::app };
+            log << text.substr(0, text.size() * Copies / 100);
+        }
+
+        std::println("File: {} bytes", std::filesystem::file_size(logName));
+
+        std::println("Full recount:");
+        {
+            ScopedTimer watch{};
+
+            IncrementalCounter counter{ logName, snapshotName };
+            counter.update();
+            std::println("{} words", counter.totalWords());
+        }
+
+        std::println("Snapshot and appended bytes:");
+        {
+            ScopedTimer watch{};
+
+            IncrementalCounter counter{ logName, snapshotName };
+            counter.loadSnapshot();
+            const std::size_t parsed{ counter.update() };
+            std::println("{} words - {} bytes parsed", counter.totalWords(), parsed);
+        }
+
+        std::filesystem::remove(logName);
+        std::filesystem::remove(snapshotName);
+    }
+}
+
+void main_incremental_word_frequency()
+{
+    IncrementalWordFrequency_SimpleTest::main_incremental_word_frequency_01();
+    IncrementalWordFrequency_SimpleTest::main_incremental_word_frequency_02();
+
+    IncrementalWordFrequency_Benchmark::main_incremental_word_frequency_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,100 @@
+// ===========================================================================
+// InvertedIndex.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include "MemoryMappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace TextIndex {
+
+    // Positional inverted index: for each word the positions (ordinal numbers of the words
+    // of the text) at which it occurs. The words are those of the SimdTokenizer,
+    // an uppercase first letter is folded to lowercase.
+    //
+    // The index is a single file, which is used memory-mapped:
+    //
+    //   Header
+    //   Terms        sorted by word - binary search, no hash table to build when opening
+    //   Strings      the words, back to back
+    //   Postings     per word: the gaps between its positions, varint encoded
+    //                (7 bits per byte, the highest bit marks a following byte)
+    //   Checkpoints  the byte offset of every 'CheckpointInterval'-th word of the text:
+    //                a position is turned into a byte offset by tokenizing at most
+    //                'CheckpointInterval' words
+    //
+    // All numbers are stored in the native byte order.
+
+    static constexpr std::uint32_t CheckpointInterval{ 64 };
+
+    // tokenizes 'text' and writes the index of it to 'indexFileName'
+    void buildIndex(std::string_view text, std::string_view indexFileName);
+
+    class InvertedIndex
+    {
+    public:
+        struct Header
+        {
+            char            m_magic[8];
+            std::uint64_t   m_numTerms;
+            std::uint64_t   m_numWords;
+            std::uint64_t   m_termsOffset;
+            std::uint64_t   m_stringsOffset;
+            std::uint64_t   m_postingsOffset;
+            std::uint64_t   m_checkpointsOffset;
+            std::uint64_t   m_numCheckpoints;
+        };
+
+        struct Term
+        {
+            std::uint64_t   m_postingsOffset;     // relative to the postings section
+            std::uint32_t   m_stringOffset;       // relative to the strings section
+            std::uint32_t   m_stringLength;
+            std::uint32_t   m_postingsBytes;
+            std::uint32_t   m_count;              // number of positions
+        };
+
+        // c'tor
+        explicit InvertedIndex(std::string_view indexFileName);
+
+        // getter
+        std::size_t numTerms() const { return static_cast<std::size_t>(m_header.m_numTerms); }
+        std::size_t numWords() const { return static_cast<std::size_t>(m_header.m_numWords); }
+        std::size_t fileSize() const { return m_file.size(); }
+
+        // number of occurrences - without decoding the postings
+        std::size_t count(std::string_view word) const;
+
+        // positions of a word, in ascending order
+        std::vector<std::uint32_t> positions(std::string_view word) const;
+
+        // start positions of a phrase (words separated by anything, that is no letter)
+        std::vector<std::uint32_t> phrase(std::string_view words) const;
+
+        // byte offset of the word at 'position' - 'text' is the indexed text
+        std::size_t byteOffset(std::uint32_t position, std::string_view text) const;
+
+        // intersection of two ascending sequences: each element of 'small' is searched
+        // in 'large' with an exponential (galloping) search, starting at the last match
+        static std::vector<std::uint32_t> intersect(std::span<const std::uint32_t> small, std::span<const std::uint32_t> large);
+
+    private:
+        bool findTerm(std::string_view word, Term& term) const;
+        std::string_view termString(const Term& term) const;
+        Term termAt(std::size_t index) const;
+
+        // member data
+        MemoryMappedFile   m_file;
+        Header             m_header;
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
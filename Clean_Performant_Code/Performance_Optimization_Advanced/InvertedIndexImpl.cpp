@@ -0,0 +1,374 @@
+// ===========================================================================
+// InvertedIndexImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "InvertedIndex.h"
+#include "SimdTokenizer.h"
+#include "StringFlatMap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace TextIndex {
+
+    static constexpr char IndexMagic[8]{ 'T', 'X', 'T', 'I', 'D', 'X', '0', '1' };
+
+    // the first letter folded to lowercase - 'folded' is the buffer, if needed
+    static std::string_view foldFirst(std::string_view word, std::string& folded)
+    {
+        if (word[0] >= 'A' && word[0] <= 'Z') {
+            folded.assign(word);
+            folded[0] = static_cast<char>(folded[0] - 'A' + 'a');
+            return folded;
+        }
+
+        return word;
+    }
+
+    // =======================================================================
+    // varint encoding
+
+    static void encodeVarint(std::uint32_t value, std::string& out)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+
+        out.push_back(static_cast<char>(value));
+    }
+
+    static std::uint32_t decodeVarint(const unsigned char*& pos)
+    {
+        std::uint32_t value{ *pos & 0x7Fu };
+        unsigned shift{ 7 };
+
+        while (*pos++ & 0x80) {
+            value |= static_cast<std::uint32_t>(*pos & 0x7F) << shift;
+            shift += 7;
+        }
+
+        return value;
+    }
+
+    static std::uint64_t alignTo8(std::uint64_t offset)
+    {
+        return (offset + 7) & ~std::uint64_t{ 7 };
+    }
+
+    // =======================================================================
+    // building
+
+    void buildIndex(std::string_view text, std::string_view indexFileName)
+    {
+        // 1. positions per word
+        StringFlatMapping::StringFlatMap<std::uint32_t> termIds;
+        std::vector<std::string_view> words;                 // indexed by term id
+        std::vector<std::vector<std::uint32_t>> postings;
+        std::vector<std::uint64_t> checkpoints;
+
+        std::string folded;
+        std::uint64_t position{};
+
+        SimdTokenizer::forEachWord(text, [&] (std::string_view word) {
+
+            if (position > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::length_error{ "buildIndex: too many words for 32-bit positions" };
+            }
+
+            if (position % CheckpointInterval == 0) {
+                checkpoints.push_back(static_cast<std::uint64_t>(word.data() - text.data()));
+            }
+
+            const std::string_view key{ foldFirst(word, folded) };
+
+            std::uint32_t& id{ termIds[key] };
+            if (id == 0) {
+                id = static_cast<std::uint32_t>(postings.size() + 1);      // 0: new word
+                postings.emplace_back();
+                words.push_back(key);
+            }
+
+            postings[id - 1].push_back(static_cast<std::uint32_t>(position));
+            ++position;
+        });
+
+        // a folded word is a view into 'folded' - take the view of the key stored in the map
+        for (auto [key, id] : termIds) {
+            words[id - 1] = key;
+        }
+
+        // 2. terms sorted by word
+        std::vector<std::uint32_t> order(words.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&] (std::uint32_t a, std::uint32_t b) { return words[a] < words[b]; });
+
+        std::vector<InvertedIndex::Term> terms(words.size());
+        std::string strings;
+        std::string encoded;
+
+        for (std::size_t i{}; i != order.size(); ++i) {
+
+            const std::uint32_t id{ order[i] };
+            InvertedIndex::Term& term{ terms[i] };
+
+            term.m_stringOffset = static_cast<std::uint32_t>(strings.size());
+            term.m_stringLength = static_cast<std::uint32_t>(words[id].size());
+            strings += words[id];
+
+            term.m_postingsOffset = encoded.size();
+            term.m_count = static_cast<std::uint32_t>(postings[id].size());
+
+            std::uint32_t previous{};
+            for (std::uint32_t pos : postings[id]) {
+                encodeVarint(pos - previous, encoded);
+                previous = pos;
+            }
+
+            term.m_postingsBytes = static_cast<std::uint32_t>(encoded.size() - term.m_postingsOffset);
+        }
+
+        // 3. the file - each section 8 byte aligned
+        InvertedIndex::Header header{};
+        std::memcpy(header.m_magic, IndexMagic, sizeof(IndexMagic));
+        header.m_numTerms = terms.size();
+        header.m_numWords = position;
+        header.m_termsOffset = alignTo8(sizeof(header));
+        header.m_stringsOffset = alignTo8(header.m_termsOffset + terms.size() * sizeof(InvertedIndex::Term));
+        header.m_postingsOffset = alignTo8(header.m_stringsOffset + strings.size());
+        header.m_checkpointsOffset = alignTo8(header.m_postingsOffset + encoded.size());
+        header.m_numCheckpoints = checkpoints.size();
+
+        std::ofstream out{ std::string{ indexFileName }, std::ios::binary | std::ios::trunc };
+        if (!out) {
+            throw std::runtime_error{ "buildIndex: unable to write " + std::string{ indexFileName } };
+        }
+
+        auto padTo = [&] (std::uint64_t offset) {
+            while (static_cast<std::uint64_t>(out.tellp()) < offset) {
+                out.put('\0');
+            }
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        padTo(header.m_termsOffset);
+        out.write(reinterpret_cast<const char*>(terms.data()), static_cast<std::streamsize>(terms.size() * sizeof(InvertedIndex::Term)));
+        padTo(header.m_stringsOffset);
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        padTo(header.m_postingsOffset);
+        out.write(encoded.data(), static_cast<std::streamsize>(encoded.size()));
+        padTo(header.m_checkpointsOffset);
+        out.write(reinterpret_cast<const char*>(checkpoints.data()), static_cast<std::streamsize>(checkpoints.size() * sizeof(std::uint64_t)));
+
+        if (!out.flush()) {
+            throw std::runtime_error{ "buildIndex: unable to write " + std::string{ indexFileName } };
+        }
+    }
+
+    // =======================================================================
+    // c'tor
+
+    InvertedIndex::InvertedIndex(std::string_view indexFileName)
+        : m_file{ indexFileName }, m_header{}
+    {
+        if (m_file.size() < sizeof(Header)) {
+            throw std::invalid_argument{ "InvertedIndex: file too small" };
+        }
+
+        std::memcpy(&m_header, m_file.view().data(), sizeof(Header));
+
+        if (std::memcmp(m_header.m_magic, IndexMagic, sizeof(IndexMagic)) != 0 ||
+            m_header.m_checkpointsOffset + m_header.m_numCheckpoints * sizeof(std::uint64_t) > m_file.size())
+        {
+            throw std::invalid_argument{ "InvertedIndex: no valid index file" };
+        }
+    }
+
+    // =======================================================================
+    // queries
+
+    std::size_t InvertedIndex::count(std::string_view word) const
+    {
+        Term term{};
+        return findTerm(word, term) ? term.m_count : 0;
+    }
+
+    std::vector<std::uint32_t> InvertedIndex::positions(std::string_view word) const
+    {
+        std::vector<std::uint32_t> result;
+
+        Term term{};
+        if (!findTerm(word, term)) {
+            return result;
+        }
+
+        result.reserve(term.m_count);
+
+        const auto* pos{ reinterpret_cast<const unsigned char*>(m_file.view().data()) + m_header.m_postingsOffset + term.m_postingsOffset };
+
+        std::uint32_t position{};
+        for (std::uint32_t i{}; i != term.m_count; ++i) {
+            position += decodeVarint(pos);
+            result.push_back(position);
+        }
+
+        return result;
+    }
+
+    std::vector<std::uint32_t> InvertedIndex::phrase(std::string_view words) const
+    {
+        // the positions of the i-th word, moved back by i: a phrase starts at a position in all lists
+        std::vector<std::vector<std::uint32_t>> lists;
+
+        std::uint32_t index{};
+        SimdTokenizer::forEachWord(words, [&] (std::string_view word) {
+
+            std::vector<std::uint32_t> list{ positions(word) };
+
+            std::erase_if(list, [&] (std::uint32_t pos) { return pos < index; });
+            for (std::uint32_t& pos : list) {
+                pos -= index;
+            }
+
+            lists.push_back(std::move(list));
+            ++index;
+        });
+
+        if (lists.empty()) {
+            return {};
+        }
+
+        // start with the shortest list - the result never grows
+        std::sort(lists.begin(), lists.end(), [] (const auto& a, const auto& b) { return a.size() < b.size(); });
+
+        std::vector<std::uint32_t> result{ std::move(lists[0]) };
+
+        for (std::size_t i{ 1 }; i != lists.size() && !result.empty(); ++i) {
+            result = intersect(result, lists[i]);
+        }
+
+        return result;
+    }
+
+    std::size_t InvertedIndex::byteOffset(std::uint32_t position, std::string_view text) const
+    {
+        const std::size_t checkpoint{ position / CheckpointInterval };
+        if (checkpoint >= m_header.m_numCheckpoints) {
+            throw std::out_of_range{ "InvertedIndex: position out of range" };
+        }
+
+        const char* checkpoints{ m_file.view().data() + m_header.m_checkpointsOffset };
+
+        std::uint64_t offset{};
+        std::memcpy(&offset, checkpoints + checkpoint * sizeof(std::uint64_t), sizeof(offset));
+
+        // the wanted word starts in front of the next checkpoint
+        std::uint64_t next{ text.size() };
+        if (checkpoint + 1 < m_header.m_numCheckpoints) {
+            std::memcpy(&next, checkpoints + (checkpoint + 1) * sizeof(std::uint64_t), sizeof(next));
+        }
+
+        // the checkpoint is the start of a word: tokenize up to the wanted one
+        const std::uint32_t skip{ position % CheckpointInterval };
+        const std::string_view rest{ text.substr(static_cast<std::size_t>(offset), static_cast<std::size_t>(next - offset)) };
+
+        std::uint32_t current{};
+        std::size_t result{ std::string_view::npos };
+
+        SimdTokenizer::forEachWord(rest, [&] (std::string_view word) {
+            if (current++ == skip) {
+                result = static_cast<std::size_t>(word.data() - text.data());
+            }
+        });
+
+        return result;
+    }
+
+    std::vector<std::uint32_t> InvertedIndex::intersect(std::span<const std::uint32_t> small, std::span<const std::uint32_t> large)
+    {
+        std::vector<std::uint32_t> result;
+
+        std::size_t low{};
+
+        for (std::uint32_t value : small) {
+
+            // gallop: double the step until the value is passed
+            std::size_t step{ 1 };
+            while (low + step < large.size() && large[low + step] < value) {
+                step *= 2;
+            }
+
+            const std::size_t high{ std::min(low + step + 1, large.size()) };
+            low = static_cast<std::size_t>(std::lower_bound(large.begin() + low, large.begin() + high, value) - large.begin());
+
+            if (low == large.size()) {
+                break;
+            }
+
+            if (large[low] == value) {
+                result.push_back(value);
+            }
+        }
+
+        return result;
+    }
+
+    // =======================================================================
+    // terms
+
+    InvertedIndex::Term InvertedIndex::termAt(std::size_t index) const
+    {
+        Term term{};
+        std::memcpy(&term, m_file.view().data() + m_header.m_termsOffset + index * sizeof(Term), sizeof(Term));
+        return term;
+    }
+
+    std::string_view InvertedIndex::termString(const Term& term) const
+    {
+        return { m_file.view().data() + m_header.m_stringsOffset + term.m_stringOffset, term.m_stringLength };
+    }
+
+    bool InvertedIndex::findTerm(std::string_view word, Term& term) const
+    {
+        if (word.empty()) {
+            return false;
+        }
+
+        std::string folded;
+        word = foldFirst(word, folded);
+
+        std::size_t low{};
+        std::size_t high{ numTerms() };
+
+        while (low < high) {
+
+            const std::size_t middle{ low + (high - low) / 2 };
+            const Term candidate{ termAt(middle) };
+
+            const std::string_view current{ termString(candidate) };
+
+            if (current == word) {
+                term = candidate;
+                return true;
+            }
+
+            if (current < word) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        return false;
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
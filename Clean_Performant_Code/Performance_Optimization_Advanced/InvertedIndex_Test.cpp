@@ -0,0 +1,164 @@
+// ===========================================================================
+// InvertedIndex_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "InvertedIndex.h"
+#include "SimdTokenizer.h"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace InvertedIndex_SimpleTest {
+
+    using namespace TextIndex;
+
+    static const std::string IndexName{ (std::filesystem::temp_directory_path() / "inverted_index_test.idx").string() };
+
+    static void main_inverted_index_01()
+    {
+        const std::string_view text{ "The quick brown fox jumps over the lazy dog. The lazy dog sleeps, the quick fox runs." };
+
+        buildIndex(text, IndexName);
+
+        InvertedIndex index{ IndexName };
+
+        std::println("{} words, {} terms, index file: {} bytes", index.numWords(), index.numTerms(), index.fileSize());
+
+        for (std::string_view query : { "the", "Fox", "cat", "lazy dog", "the quick fox", "dog the" }) {
+
+            const std::vector<std::uint32_t> found{ index.phrase(query) };
+
+            std::print("{:<16}:", query);
+            for (std::uint32_t position : found) {
+                std::print(" {} (byte {})", position, index.byteOffset(position, text));
+            }
+            std::println();
+        }
+
+        std::filesystem::remove(IndexName);
+    }
+
+    // galloping intersection against the naive scan
+    static void main_inverted_index_02()
+    {
+        const std::vector<std::uint32_t> small{ 3, 17, 100, 5'000, 70'000, 99'999 };
+
+        std::vector<std::uint32_t> large;
+        for (std::uint32_t i{}; i < 100'000; i += 3) {
+            large.push_back(i);
+        }
+
+        std::print("intersect:");
+        for (std::uint32_t value : InvertedIndex::intersect(small, large)) {
+            std::print(" {}", value);
+        }
+        std::println();
+    }
+}
+
+namespace InvertedIndex_Benchmark {
+
+    using namespace TextIndex;
+
+#ifdef _DEBUG
+    static constexpr std::size_t Queries = 1'000;        // debug
+#else
+    static constexpr std::size_t Queries = 10'000;       // release
+#endif
+
+    static void main_inverted_index_20()
+    {
+        const std::string indexName{ (std::filesystem::temp_directory_path() / "inverted_index_bench.idx").string() };
+
+        std::ifstream file{ "LoremIpsumHuge.txt", std::ios::binary };
+        const std::string text{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+        std::println("Build:");
+        {
+            const auto begin{ std::chrono::steady_clock::now() };
+
+            buildIndex(text, indexName);
+
+            const std::chrono::duration<double> seconds{ std::chrono::steady_clock::now() - begin };
+            std::println("{:.1f} ms - {:.1f} MB/s", seconds.count() * 1'000.0, text.size() / seconds.count() / (1'024.0 * 1'024.0));
+        }
+
+        InvertedIndex index{ indexName };
+
+        std::println("Text: {} bytes - index: {} bytes ({:.1f} %) - {} words, {} terms",
+            text.size(), index.fileSize(), 100.0 * index.fileSize() / text.size(), index.numWords(), index.numTerms());
+
+        // queries: words and phrases taken from the text
+        std::vector<std::string_view> words;
+        SimdTokenizer::forEachWord(text, [&] (std::string_view word) { words.push_back(word); });
+
+        std::mt19937 generator{ 4711 };
+        std::uniform_int_distribution<std::size_t> distribution{ 0, words.size() - 3 };
+
+        for (std::size_t length : { 1, 2, 3 }) {
+
+            std::vector<std::string> queries;
+            for (std::size_t i{}; i != Queries; ++i) {
+                const std::size_t start{ distribution(generator) };
+                const char* first{ words[start].data() };
+                const char* last{ words[start + length - 1].data() + words[start + length - 1].size() };
+                queries.emplace_back(first, last);
+            }
+
+            std::size_t hits{};
+
+            const auto begin{ std::chrono::steady_clock::now() };
+
+            for (const std::string& query : queries) {
+                hits += index.phrase(query).size();
+            }
+
+            const std::chrono::duration<double> seconds{ std::chrono::steady_clock::now() - begin };
+
+            std::println("{}-word queries: {:>8.1f} us per query - {:>8.0f} queries/s - {:.1f} hits per query",
+                length, seconds.count() * 1'000'000.0 / Queries, Queries / seconds.count(), static_cast<double>(hits) / Queries);
+        }
+
+        // for comparison: a phrase searched in the text
+        std::println("std::string_view::find, 2-word phrase, {} queries:", Queries / 100);
+        {
+            ScopedTimer watch{};
+
+            std::size_t hits{};
+            for (std::size_t i{}; i != Queries / 100; ++i) {
+                const std::size_t start{ distribution(generator) };
+                const std::string phrase{ words[start].data(), words[start + 1].data() + words[start + 1].size() };
+
+                for (std::size_t pos{ text.find(phrase) }; pos != std::string::npos; pos = text.find(phrase, pos + 1)) {
+                    ++hits;
+                }
+            }
+
+            std::println("{:.1f} hits per query", static_cast<double>(hits) / (Queries / 100));
+        }
+
+        std::filesystem::remove(indexName);
+    }
+}
+
+void main_inverted_index()
+{
+    InvertedIndex_SimpleTest::main_inverted_index_01();
+    InvertedIndex_SimpleTest::main_inverted_index_02();
+
+    InvertedIndex_Benchmark::main_inverted_index_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,305 @@
+// ===========================================================================
+// MemoryMappedFile.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// thin RAII wrapper around the operating system's file mapping API
+// (MapViewOfFile on Windows, mmap on POSIX systems)
+
+class MemoryMappedFile
+{
+public:
+    enum class Mode { ReadOnly, ReadWrite };
+
+    // c'tor/d'tor
+    MemoryMappedFile() = default;
+    MemoryMappedFile(std::string_view fileName, Mode mode = Mode::ReadOnly, std::size_t size = 0);
+    ~MemoryMappedFile();
+
+    // no copy, but move
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    // public interface
+    // Note: In mode 'ReadWrite' the file is created, if necessary,
+    // and resized to 'size' bytes, if 'size' is not zero.
+    bool open(std::string_view fileName, Mode mode = Mode::ReadOnly, std::size_t size = 0);
+    void close() noexcept;
+    void flush() noexcept;
+
+    // hint: the mapping will be read sequentially (read-ahead of the pages)
+    void adviseSequential() noexcept;
+
+    // getter
+    std::byte*       data() noexcept { return m_data; }
+    const std::byte* data() const noexcept { return m_data; }
+    std::size_t      size() const noexcept { return m_size; }
+    bool             isOpen() const noexcept { return m_data != nullptr; }
+    bool             isNew() const noexcept { return m_isNew; }
+
+    std::string_view view() const noexcept {
+        return { reinterpret_cast<const char*>(m_data), m_size };
+    }
+
+private:
+    void swap(MemoryMappedFile& other) noexcept;
+
+    std::byte*   m_data{ nullptr };
+    std::size_t  m_size{ 0 };
+    bool         m_isNew{ false };
+
+#if defined(_WIN32)
+    HANDLE       m_file{ INVALID_HANDLE_VALUE };
+    HANDLE       m_mapping{ nullptr };
+#else
+    int          m_file{ -1 };
+#endif
+};
+
+inline MemoryMappedFile::MemoryMappedFile(std::string_view fileName, Mode mode, std::size_t size)
+{
+    if (!open(fileName, mode, size)) {
+        throw std::invalid_argument{ "Unable to map file" };
+    }
+}
+
+inline MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+inline MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+{
+    swap(other);
+}
+
+inline MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        swap(other);
+    }
+
+    return *this;
+}
+
+inline void MemoryMappedFile::swap(MemoryMappedFile& other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_isNew, other.m_isNew);
+    std::swap(m_file, other.m_file);
+#if defined(_WIN32)
+    std::swap(m_mapping, other.m_mapping);
+#endif
+}
+
+#if defined(_WIN32)
+
+inline bool MemoryMappedFile::open(std::string_view fileName, Mode mode, std::size_t size)
+{
+    close();
+
+    std::string name{ fileName };
+    bool writable{ mode == Mode::ReadWrite };
+
+    m_file = ::CreateFileA(
+        name.c_str(),
+        writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        writable ? OPEN_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    m_isNew = writable && ::GetLastError() != ERROR_ALREADY_EXISTS;
+
+    LARGE_INTEGER fileSize{};
+    ::GetFileSizeEx(m_file, &fileSize);
+
+    m_size = (size != 0) ? size : static_cast<std::size_t>(fileSize.QuadPart);
+    if (m_size == 0) {
+        close();
+        return false;
+    }
+
+    // a writable mapping object grows the file to the requested size
+    LARGE_INTEGER mappingSize{};
+    mappingSize.QuadPart = static_cast<LONGLONG>(m_size);
+
+    m_mapping = ::CreateFileMappingA(
+        m_file,
+        nullptr,
+        writable ? PAGE_READWRITE : PAGE_READONLY,
+        writable ? mappingSize.HighPart : 0,
+        writable ? mappingSize.LowPart : 0,
+        nullptr
+    );
+
+    if (m_mapping == nullptr) {
+        close();
+        return false;
+    }
+
+    void* view{ ::MapViewOfFile(m_mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_size) };
+    if (view == nullptr) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<std::byte*>(view);
+    return true;
+}
+
+inline void MemoryMappedFile::close() noexcept
+{
+    if (m_data != nullptr) {
+        ::UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+
+    if (m_mapping != nullptr) {
+        ::CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+
+    if (m_file != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+
+    m_size = 0;
+}
+
+inline void MemoryMappedFile::flush() noexcept
+{
+    if (m_data != nullptr) {
+        ::FlushViewOfFile(m_data, m_size);
+    }
+}
+
+inline void MemoryMappedFile::adviseSequential() noexcept
+{
+    if (m_data != nullptr) {
+        WIN32_MEMORY_RANGE_ENTRY range{ m_data, m_size };
+        ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+    }
+}
+
+#else
+
+inline bool MemoryMappedFile::open(std::string_view fileName, Mode mode, std::size_t size)
+{
+    close();
+
+    std::string name{ fileName };
+    bool writable{ mode == Mode::ReadWrite };
+
+    m_isNew = writable && ::access(name.c_str(), F_OK) != 0;
+
+    m_file = ::open(name.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (m_file == -1) {
+        return false;
+    }
+
+    struct stat info {};
+    if (::fstat(m_file, &info) != 0) {
+        close();
+        return false;
+    }
+
+    m_size = (size != 0) ? size : static_cast<std::size_t>(info.st_size);
+    if (m_size == 0) {
+        close();
+        return false;
+    }
+
+    if (writable && static_cast<std::size_t>(info.st_size) != m_size) {
+        if (::ftruncate(m_file, static_cast<off_t>(m_size)) != 0) {
+            close();
+            return false;
+        }
+    }
+
+    void* view{ ::mmap(
+        nullptr,
+        m_size,
+        writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+        MAP_SHARED,
+        m_file,
+        0
+    ) };
+
+    if (view == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<std::byte*>(view);
+    return true;
+}
+
+inline void MemoryMappedFile::close() noexcept
+{
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+
+    if (m_file != -1) {
+        ::close(m_file);
+        m_file = -1;
+    }
+
+    m_size = 0;
+}
+
+inline void MemoryMappedFile::flush() noexcept
+{
+    if (m_data != nullptr) {
+        ::msync(m_data, m_size, MS_SYNC);
+    }
+}
+
+inline void MemoryMappedFile::adviseSequential() noexcept
+{
+    if (m_data != nullptr) {
+        ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+        ::madvise(m_data, m_size, MADV_WILLNEED);
+    }
+}
+
+#endif
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
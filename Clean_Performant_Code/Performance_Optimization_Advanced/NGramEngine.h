@@ -0,0 +1,122 @@
+// ===========================================================================
+// NGramEngine.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include "StringInterner.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace NGrams {
+
+    // Open addressing map from 64-bit keys to counts - the key 0 marks an empty slot.
+    // Two arrays (keys, counts), linear probing, Fibonacci hashing.
+    class FlatCountMap
+    {
+    public:
+        // c'tor
+        FlatCountMap();
+
+        void add(std::uint64_t key, std::uint64_t count = 1);
+        void merge(const FlatCountMap& other);
+
+        std::uint64_t find(std::uint64_t key) const;     // 0, if the key is missing
+
+        std::size_t size() const { return m_size; }
+
+        // the entries in ascending order of the keys
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> sorted() const;
+
+    private:
+        std::size_t slotOf(std::uint64_t key) const {
+            return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+        }
+
+        void grow();
+
+        // member data
+        std::vector<std::uint64_t>  m_keys;
+        std::vector<std::uint64_t>  m_counts;
+        std::size_t                 m_size;
+        unsigned                    m_shift;      // 64 - log2(capacity)
+    };
+
+    struct NGramCount
+    {
+        std::string     m_ngram;      // the words, separated by a blank
+        std::uint64_t   m_count;
+    };
+
+    // Unigram, bigram and trigram statistics:
+    //
+    //  * Each word gets a dense id (1, 2, 3, ... - a StringInterner of its own).
+    //    Like in TextfileStatistics, an uppercase first letter is folded to lowercase.
+    //  * An n-gram is a packed 64-bit key: the ids of its words (21 bits each),
+    //    the first word in the highest bits.
+    //  * The text is split into one chunk per thread. Each thread tokenizes its chunk
+    //    into ids, then counts the n-grams starting in its chunk into maps of its own.
+    //    The maps are merged at the end.
+    //  * The merged counts are kept sorted by key: all n-grams starting with the same
+    //    words are a contiguous range - a prefix query is a binary search.
+
+    class NGramEngine
+    {
+    public:
+        static constexpr std::size_t MaxN{ 3 };
+        static constexpr unsigned IdBits{ 21 };
+        static constexpr std::uint32_t MaxId{ (1u << IdBits) - 1 };
+
+        // c'tor
+        NGramEngine();
+
+        // counts the n-grams of 'text' - the counts of previous calls are replaced
+        void count(std::string_view text, std::size_t numThreads = 0);
+
+        // getter
+        std::size_t vocabularySize() const { return m_words.size(); }
+        std::uint64_t total(std::size_t n) const;
+        std::size_t distinct(std::size_t n) const;
+
+        // the k most frequent n-grams (n = 1, 2, 3)
+        std::vector<NGramCount> topK(std::size_t n, std::size_t k) const;
+
+        // the k most frequent continuations of a prefix of 1 or 2 words (separated by blanks):
+        // topKAfter("lorem", 5) - the most frequent bigrams starting with "lorem"
+        std::vector<NGramCount> topKAfter(std::string_view prefix, std::size_t k) const;
+
+        // packing
+        static std::uint64_t pack(std::uint32_t w1, std::uint32_t w2) {
+            return (std::uint64_t{ w1 } << IdBits) | w2;
+        }
+
+        static std::uint64_t pack(std::uint32_t w1, std::uint32_t w2, std::uint32_t w3) {
+            return (std::uint64_t{ w1 } << (2 * IdBits)) | (std::uint64_t{ w2 } << IdBits) | w3;
+        }
+
+    private:
+        std::vector<std::uint32_t> tokenize(std::string_view text);
+        std::string toString(std::uint64_t key, std::size_t n) const;
+
+        using SortedCounts = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+        std::vector<NGramCount> topKOf(SortedCounts::const_iterator begin, SortedCounts::const_iterator end,
+            std::size_t n, std::size_t k) const;
+
+        // member data
+        StringInterning::StringInterner   m_words;
+        std::vector<std::uint64_t>        m_unigrams;      // indexed by the word id
+        SortedCounts                      m_bigrams;
+        SortedCounts                      m_trigrams;
+        std::uint64_t                     m_totals[MaxN];
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,370 @@
+// ===========================================================================
+// NGramEngineImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "NGramEngine.h"
+#include "SimdTokenizer.h"
+#include "WordFrequencyEngine.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace NGrams {
+
+    // =======================================================================
+    // FlatCountMap
+
+    static constexpr unsigned InitialBits{ 10 };
+
+    FlatCountMap::FlatCountMap()
+        : m_keys(std::size_t{ 1 } << InitialBits), m_counts(std::size_t{ 1 } << InitialBits),
+          m_size{}, m_shift{ 64 - InitialBits }
+    {
+    }
+
+    void FlatCountMap::add(std::uint64_t key, std::uint64_t count)
+    {
+        const std::size_t mask{ m_keys.size() - 1 };
+
+        for (std::size_t slot{ slotOf(key) }; ; slot = (slot + 1) & mask) {
+
+            if (m_keys[slot] == key) {
+                m_counts[slot] += count;
+                return;
+            }
+
+            if (m_keys[slot] == 0) {
+
+                // keep the load factor below 1/2 - short probe sequences
+                if (2 * (m_size + 1) > m_keys.size()) {
+                    grow();
+                    add(key, count);
+                    return;
+                }
+
+                m_keys[slot] = key;
+                m_counts[slot] = count;
+                ++m_size;
+                return;
+            }
+        }
+    }
+
+    void FlatCountMap::merge(const FlatCountMap& other)
+    {
+        for (std::size_t i{}; i != other.m_keys.size(); ++i) {
+            if (other.m_keys[i] != 0) {
+                add(other.m_keys[i], other.m_counts[i]);
+            }
+        }
+    }
+
+    std::uint64_t FlatCountMap::find(std::uint64_t key) const
+    {
+        const std::size_t mask{ m_keys.size() - 1 };
+
+        for (std::size_t slot{ slotOf(key) }; m_keys[slot] != 0; slot = (slot + 1) & mask) {
+            if (m_keys[slot] == key) {
+                return m_counts[slot];
+            }
+        }
+
+        return 0;
+    }
+
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> FlatCountMap::sorted() const
+    {
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> entries;
+        entries.reserve(m_size);
+
+        for (std::size_t i{}; i != m_keys.size(); ++i) {
+            if (m_keys[i] != 0) {
+                entries.emplace_back(m_keys[i], m_counts[i]);
+            }
+        }
+
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    void FlatCountMap::grow()
+    {
+        std::vector<std::uint64_t> keys(2 * m_keys.size());
+        std::vector<std::uint64_t> counts(2 * m_keys.size());
+
+        std::swap(keys, m_keys);
+        std::swap(counts, m_counts);
+        --m_shift;
+
+        const std::size_t mask{ m_keys.size() - 1 };
+
+        for (std::size_t i{}; i != keys.size(); ++i) {
+
+            if (keys[i] != 0) {
+
+                std::size_t slot{ slotOf(keys[i]) };
+                while (m_keys[slot] != 0) {
+                    slot = (slot + 1) & mask;
+                }
+
+                m_keys[slot] = keys[i];
+                m_counts[slot] = counts[i];
+            }
+        }
+    }
+
+    // =======================================================================
+    // NGramEngine - c'tor
+
+    NGramEngine::NGramEngine()
+        : m_words{}, m_unigrams{}, m_bigrams{}, m_trigrams{}, m_totals{}
+    {
+    }
+
+    // =======================================================================
+    // counting
+
+    void NGramEngine::count(std::string_view text, std::size_t numThreads)
+    {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        const std::vector<std::size_t> bounds{ WordFrequency::Engine::split(text, numThreads) };
+
+        // 1. each thread maps the words of its chunk to ids (the interner is thread-safe)
+        std::vector<std::vector<std::uint32_t>> ids(numThreads);
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t t{}; t != numThreads; ++t) {
+                threads.emplace_back([&, t] () {
+                    ids[t] = tokenize(text.substr(bounds[t], bounds[t + 1] - bounds[t]));
+                });
+            }
+        }
+
+        if (m_words.size() > MaxId) {
+            throw std::length_error{ "NGramEngine: too many distinct words for packed keys" };
+        }
+
+        // 2. each thread counts the n-grams starting in its chunk - the last ones
+        //    end in the following chunks
+        const std::size_t vocabulary{ m_words.size() + 1 };
+
+        std::vector<std::vector<std::uint64_t>> unigrams(numThreads);
+        std::vector<FlatCountMap> bigrams(numThreads);
+        std::vector<FlatCountMap> trigrams(numThreads);
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t t{}; t != numThreads; ++t) {
+                threads.emplace_back([&, t] () {
+
+                    std::vector<std::uint32_t> words{ ids[t] };
+
+                    // the first (up to) 2 words behind the chunk
+                    std::size_t lookahead{};
+                    for (std::size_t next{ t + 1 }; next != numThreads && lookahead < MaxN - 1; ++next) {
+                        for (std::size_t i{}; i != ids[next].size() && lookahead < MaxN - 1; ++i, ++lookahead) {
+                            words.push_back(ids[next][i]);
+                        }
+                    }
+
+                    const std::size_t own{ ids[t].size() };
+
+                    unigrams[t].resize(vocabulary);
+
+                    for (std::size_t i{}; i != own; ++i) {
+
+                        ++unigrams[t][words[i]];
+
+                        if (i + 1 < words.size()) {
+                            bigrams[t].add(pack(words[i], words[i + 1]));
+                        }
+
+                        if (i + 2 < words.size()) {
+                            trigrams[t].add(pack(words[i], words[i + 1], words[i + 2]));
+                        }
+                    }
+                });
+            }
+        }
+
+        // 3. merge
+        for (std::size_t t{ 1 }; t != numThreads; ++t) {
+
+            for (std::size_t id{}; id != vocabulary; ++id) {
+                unigrams[0][id] += unigrams[t][id];
+            }
+
+            bigrams[0].merge(bigrams[t]);
+            trigrams[0].merge(trigrams[t]);
+        }
+
+        m_unigrams = std::move(unigrams[0]);
+        m_bigrams = bigrams[0].sorted();
+        m_trigrams = trigrams[0].sorted();
+
+        std::fill(std::begin(m_totals), std::end(m_totals), 0);
+
+        for (const auto& word : ids) {
+            m_totals[0] += word.size();
+        }
+
+        for (const auto& [key, count] : m_bigrams) {
+            m_totals[1] += count;
+        }
+
+        for (const auto& [key, count] : m_trigrams) {
+            m_totals[2] += count;
+        }
+    }
+
+    std::vector<std::uint32_t> NGramEngine::tokenize(std::string_view text)
+    {
+        std::vector<std::uint32_t> ids;
+        std::string folded;
+
+        SimdTokenizer::forEachWord(text, [&] (std::string_view word) {
+
+            if (word[0] >= 'A' && word[0] <= 'Z') {
+                folded.assign(word);
+                folded[0] = static_cast<char>(folded[0] - 'A' + 'a');
+                word = folded;
+            }
+
+            ids.push_back(m_words.intern(word).m_id);
+        });
+
+        return ids;
+    }
+
+    // =======================================================================
+    // queries
+
+    std::uint64_t NGramEngine::total(std::size_t n) const
+    {
+        return (n >= 1 && n <= MaxN) ? m_totals[n - 1] : 0;
+    }
+
+    std::size_t NGramEngine::distinct(std::size_t n) const
+    {
+        switch (n)
+        {
+        case 1:
+            return static_cast<std::size_t>(std::count_if(m_unigrams.begin(), m_unigrams.end(), [] (std::uint64_t count) { return count != 0; }));
+        case 2:
+            return m_bigrams.size();
+        case 3:
+            return m_trigrams.size();
+        default:
+            return 0;
+        }
+    }
+
+    std::vector<NGramCount> NGramEngine::topK(std::size_t n, std::size_t k) const
+    {
+        if (n == 1) {
+
+            SortedCounts unigrams;
+            for (std::size_t id{ 1 }; id < m_unigrams.size(); ++id) {
+                if (m_unigrams[id] != 0) {
+                    unigrams.emplace_back(id, m_unigrams[id]);
+                }
+            }
+
+            return topKOf(unigrams.cbegin(), unigrams.cend(), 1, k);
+        }
+
+        if (n == 2) {
+            return topKOf(m_bigrams.cbegin(), m_bigrams.cend(), 2, k);
+        }
+
+        if (n == 3) {
+            return topKOf(m_trigrams.cbegin(), m_trigrams.cend(), 3, k);
+        }
+
+        throw std::out_of_range{ "NGramEngine: n must be 1, 2 or 3" };
+    }
+
+    std::vector<NGramCount> NGramEngine::topKAfter(std::string_view prefix, std::size_t k) const
+    {
+        // the ids of the prefix words
+        std::vector<std::uint32_t> ids;
+        std::string folded;
+
+        SimdTokenizer::forEachWord(prefix, [&] (std::string_view word) {
+
+            if (word[0] >= 'A' && word[0] <= 'Z') {
+                folded.assign(word);
+                folded[0] = static_cast<char>(folded[0] - 'A' + 'a');
+                word = folded;
+            }
+
+            ids.push_back(m_words.find(word).m_id);
+        });
+
+        if (ids.empty() || ids.size() >= MaxN) {
+            throw std::invalid_argument{ "NGramEngine: the prefix must have 1 or 2 words" };
+        }
+
+        // an unknown word
+        if (std::find(ids.begin(), ids.end(), 0u) != ids.end()) {
+            return {};
+        }
+
+        // all n-grams with this prefix: keys in [prefix << IdBits, (prefix + 1) << IdBits)
+        const SortedCounts& counts{ (ids.size() == 1) ? m_bigrams : m_trigrams };
+        const std::uint64_t first{ (ids.size() == 1) ? ids[0] : pack(ids[0], ids[1]) };
+
+        auto begin{ std::lower_bound(counts.begin(), counts.end(), std::pair<std::uint64_t, std::uint64_t>{ first << IdBits, 0 }) };
+        auto end{ std::lower_bound(begin, counts.end(), std::pair<std::uint64_t, std::uint64_t>{ (first + 1) << IdBits, 0 }) };
+
+        return topKOf(begin, end, ids.size() + 1, k);
+    }
+
+    std::vector<NGramCount> NGramEngine::topKOf(SortedCounts::const_iterator begin, SortedCounts::const_iterator end,
+        std::size_t n, std::size_t k) const
+    {
+        SortedCounts entries{ begin, end };
+
+        k = std::min(k, entries.size());
+
+        std::partial_sort(entries.begin(), entries.begin() + k, entries.end(),
+            [] (const auto& a, const auto& b) { return a.second > b.second; }
+        );
+
+        std::vector<NGramCount> result;
+        result.reserve(k);
+
+        for (std::size_t i{}; i != k; ++i) {
+            result.push_back(NGramCount{ toString(entries[i].first, n), entries[i].second });
+        }
+
+        return result;
+    }
+
+    std::string NGramEngine::toString(std::uint64_t key, std::size_t n) const
+    {
+        std::string ngram;
+
+        for (std::size_t i{ n }; i-- != 0; ) {
+
+            const auto id{ static_cast<std::uint32_t>((key >> (i * IdBits)) & MaxId) };
+
+            if (!ngram.empty()) {
+                ngram += ' ';
+            }
+
+            ngram += m_words.view(StringInterning::Symbol{ id });
+        }
+
+        return ngram;
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
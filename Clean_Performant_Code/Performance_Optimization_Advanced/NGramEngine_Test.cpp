@@ -0,0 +1,170 @@
+// ===========================================================================
+// NGramEngine_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "NGramEngine.h"
+#include "SimdTokenizer.h"
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace NGramEngine_SimpleTest {
+
+    using namespace NGrams;
+
+    static std::string readFile(const char* fileName)
+    {
+        std::ifstream file{ fileName, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    }
+
+    static void print(const std::vector<NGramCount>& ngrams)
+    {
+        for (const auto& [ngram, count] : ngrams) {
+            std::println("  {:>6}: {}", count, ngram);
+        }
+    }
+
+    static void main_ngram_engine_01()
+    {
+        NGramEngine engine;
+        engine.count("The cat sat on the mat. The cat ate the rat. A cat sat on the hat.", 2);
+
+        std::println("Vocabulary: {} - bigrams: {} of {} - trigrams: {} of {}",
+            engine.vocabularySize(), engine.distinct(2), engine.total(2), engine.distinct(3), engine.total(3));
+
+        std::println("Top bigrams:");
+        print(engine.topK(2, 3));
+
+        std::println("After 'the':");
+        print(engine.topKAfter("the", 5));
+
+        std::println("After 'cat sat':");
+        print(engine.topKAfter("cat sat", 5));
+
+        // every word of the prefix is folded as in the text: the same as 'the cat'
+        std::println("After 'The Cat':");
+        print(engine.topKAfter("The Cat", 5));
+    }
+
+    // the same counts with 1 and 4 threads
+    static void main_ngram_engine_02()
+    {
+        const std::string text{ readFile("LoremIpsumHuge.txt") };
+
+        NGramEngine single;
+        single.count(text, 1);
+
+        NGramEngine parallel;
+        parallel.count(text, 4);
+
+        bool same{ true };
+        for (std::size_t n{ 1 }; n <= NGramEngine::MaxN; ++n) {
+            same = same && single.total(n) == parallel.total(n) && single.distinct(n) == parallel.distinct(n);
+        }
+
+        std::println("LoremIpsumHuge.txt: {} words, {} bigrams, {} trigrams - same with 1 and 4 threads: {}",
+            single.distinct(1), single.distinct(2), single.distinct(3), same);
+
+        const auto top{ single.topK(1, 1) };
+        std::println("Most frequent word: {} ({}) - followed by:", top.front().m_ngram, top.front().m_count);
+        print(single.topKAfter(top.front().m_ngram, 3));
+    }
+}
+
+namespace NGramEngine_Benchmark {
+
+    using namespace NGrams;
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 1;         // debug
+#else
+    static constexpr int Rounds = 5;         // release
+#endif
+
+    static void main_ngram_engine_20()
+    {
+        const std::string text{ NGramEngine_SimpleTest::readFile("LoremIpsumHuge.txt") };
+
+        std::println("LoremIpsumHuge.txt: {} bytes, {} rounds", text.size(), Rounds);
+
+        std::println("String keys - std::unordered_map<std::string, std::size_t>:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+
+                // the first letter folded to lowercase, like the engine does
+                std::vector<std::string> words;
+                SimdTokenizer::forEachWord(text, [&] (std::string_view word) {
+                    std::string s{ word };
+                    if (s[0] >= 'A' && s[0] <= 'Z') {
+                        s[0] = static_cast<char>(s[0] - 'A' + 'a');
+                    }
+                    words.push_back(std::move(s));
+                });
+
+                std::unordered_map<std::string, std::size_t> bigrams;
+                std::unordered_map<std::string, std::size_t> trigrams;
+
+                for (std::size_t i{}; i + 1 < words.size(); ++i) {
+
+                    std::string key{ words[i] };
+                    key += ' ';
+                    key += words[i + 1];
+                    ++bigrams[key];
+
+                    if (i + 2 < words.size()) {
+                        key += ' ';
+                        key += words[i + 2];
+                        ++trigrams[key];
+                    }
+                }
+
+                if (round == 0) {
+                    std::println("{} bigrams, {} trigrams", bigrams.size(), trigrams.size());
+                }
+            }
+        }
+
+        for (std::size_t threads : { std::size_t{ 1 }, std::size_t{ 4 }, std::size_t{ std::thread::hardware_concurrency() } }) {
+
+            std::println("Packed keys - {} thread(s):", threads);
+            {
+                ScopedTimer watch{};
+
+                for (int round{}; round != Rounds; ++round) {
+
+                    NGramEngine engine;
+                    engine.count(text, threads);
+
+                    if (round == 0) {
+                        std::println("{} bigrams, {} trigrams", engine.distinct(2), engine.distinct(3));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void main_ngram_engine()
+{
+    NGramEngine_SimpleTest::main_ngram_engine_01();
+    NGramEngine_SimpleTest::main_ngram_engine_02();
+
+    NGramEngine_Benchmark::main_ngram_engine_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,391 @@
+// ===========================================================================
+// ObjectPool_Adaptive.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace AdaptiveObjectPool {
+
+    // Object pool, that adapts its capacity to the observed load:
+    //
+    //  * The pool consists of chunks, each chunk has its own list of free objects.
+    //    Objects are taken from the oldest chunk with free objects first,
+    //    so the newest chunks are the first ones to become completely unused.
+    //
+    //  * acquireObject / releaseObject just count: acquires, releases, in-use
+    //    count and peak. A miss - no free object, the pool has to grow
+    //    on the hot path - is counted, too.
+    //
+    //  * maintain() is called periodically (e.g. once per frame or tick),
+    //    it computes the acquire rate and
+    //     - pre-grows the pool: if the peak in-use count has grown in the last
+    //       two intervals, this trend is extrapolated for 'lookAhead' - the
+    //       capacity has to cover the prediction plus 'headroom'. A single
+    //       step (a burst) is no trend, it is covered by the headroom only
+    //     - trims chunks, that have been unused for 'quietPeriod', as long as
+    //       the remaining capacity covers the recent peak plus headroom.
+    //    Growth happens between two intervals then - not on the hot path.
+
+    using Clock = std::chrono::steady_clock;
+
+    struct PoolOptions
+    {
+        std::size_t               m_initialCapacity{ 0 };      // allocated by the c'tor
+        std::size_t               m_minChunkSize{ 16 };
+        std::size_t               m_maxChunkSize{ 64 * 1'024 };
+        double                    m_headroom{ 0.25 };           // spare capacity, relative to the in-use count
+        std::chrono::milliseconds m_lookAhead{ 100 };
+        std::chrono::milliseconds m_quietPeriod{ 1'000 };
+    };
+
+    struct PoolStatistics
+    {
+        std::size_t m_acquires{};
+        std::size_t m_releases{};
+        std::size_t m_misses{};          // growth on the hot path
+        std::size_t m_preGrowths{};      // growth by maintain()
+        std::size_t m_trims{};
+        std::size_t m_inUse{};
+        std::size_t m_peakInUse{};
+        std::size_t m_capacity{};
+        std::size_t m_chunks{};
+        double      m_acquireRate{};     // acquires per second, between the last two maintain() calls
+    };
+
+    template <typename T, typename TAllocator>
+    class ObjectPool;
+
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class PoolDeleter
+    {
+    public:
+        PoolDeleter() noexcept = default;
+        explicit PoolDeleter(ObjectPool<T, TAllocator>* pool) noexcept : m_pool{ pool } {}
+
+        void operator()(T* object) const noexcept;
+
+    private:
+        ObjectPool<T, TAllocator>* m_pool{ nullptr };
+    };
+
+    template <typename T, typename TAllocator = std::allocator<T>>
+    using PooledPtr = std::unique_ptr<T, PoolDeleter<T, TAllocator>>;
+
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class ObjectPool final
+    {
+    public:
+        using value_type = T;
+
+        // c'tor / d'tor
+        explicit ObjectPool(const PoolOptions& options = {}, const TAllocator& allocator = {});
+        ~ObjectPool();
+
+        // no copy / no move
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        template <typename ... TArgs>
+        PooledPtr<T, TAllocator> acquireObject(TArgs&&... args);
+
+        // periodic housekeeping: measures the acquire rate, pre-grows and trims
+        void maintain(Clock::time_point now = Clock::now());
+
+        const PoolStatistics& statistics() const noexcept { return m_statistics; }
+        const PoolOptions& options() const noexcept { return m_options; }
+
+    private:
+        friend class PoolDeleter<T, TAllocator>;
+
+        static constexpr std::size_t PageSize{ 4'096 };
+
+        struct Chunk
+        {
+            T*                m_objects;
+            std::size_t       m_size;
+            std::vector<T*>   m_free;
+            Clock::time_point m_idleSince;   // valid, if all objects are free
+        };
+
+        // private helper methods
+        void releaseObject(T* object) noexcept;
+        void addChunk(std::size_t size);
+        void removeChunk(std::size_t index) noexcept;
+        std::size_t findChunk(const T* object) const noexcept;
+        std::size_t freeObjects() const noexcept { return m_statistics.m_capacity - m_statistics.m_inUse; }
+
+        // member data
+        PoolOptions               m_options;
+        PoolStatistics            m_statistics;
+        std::vector<Chunk>        m_chunks;               // in order of creation
+        std::vector<std::size_t>  m_byAddress;            // chunk indices, sorted by address
+        std::size_t               m_firstAvailable;       // no chunk before this one has free objects
+        std::size_t               m_lastReleased;         // chunk of the last released object
+        const T*                  m_lastReleasedBegin;
+        const T*                  m_lastReleasedEnd;
+        Clock::time_point         m_now;                  // time of the last maintain() call
+        std::size_t               m_acquiresAtMaintain;
+        std::size_t               m_intervalPeak;         // peak in-use count since the last maintain() call
+        std::size_t               m_lastIntervalPeak;
+        std::size_t               m_lastGrowth;           // growth of the peak in the previous interval
+        std::size_t               m_recentPeak;           // peak in-use count of the current quiet period
+        Clock::time_point         m_recentPeakSince;
+        TAllocator                m_allocator;
+    };
+
+    // =======================================================================
+    // c'tor / d'tor
+
+    template <typename T, typename TAllocator>
+    inline ObjectPool<T, TAllocator>::ObjectPool(const PoolOptions& options, const TAllocator& allocator)
+        : m_options{ options }, m_statistics{}, m_firstAvailable{},
+          m_lastReleased{}, m_lastReleasedBegin{ nullptr }, m_lastReleasedEnd{ nullptr },
+          m_now{ Clock::now() }, m_acquiresAtMaintain{},
+          m_intervalPeak{}, m_lastIntervalPeak{}, m_lastGrowth{}, m_recentPeak{}, m_recentPeakSince{ m_now },
+          m_allocator{ allocator }
+    {
+        assert(m_options.m_minChunkSize > 0 && m_options.m_minChunkSize <= m_options.m_maxChunkSize);
+
+        // the expected load is known up front: no first-burst latency spike
+        if (m_options.m_initialCapacity > 0) {
+            addChunk(m_options.m_initialCapacity);
+        }
+    }
+
+    template <typename T, typename TAllocator>
+    inline ObjectPool<T, TAllocator>::~ObjectPool()
+    {
+        // Note: all objects handed out by this pool must have been
+        //       returned to the pool before the pool is destroyed.
+        assert(m_statistics.m_inUse == 0);
+
+        for (auto& chunk : m_chunks) {
+            m_allocator.deallocate(chunk.m_objects, chunk.m_size);
+        }
+    }
+
+    // =======================================================================
+    // public interface
+
+    template <typename T, typename TAllocator>
+    template <typename... TArgs>
+    inline PooledPtr<T, TAllocator> ObjectPool<T, TAllocator>::acquireObject(TArgs&& ... args)
+    {
+        // find the oldest chunk with free objects
+        while (m_firstAvailable != m_chunks.size() && m_chunks[m_firstAvailable].m_free.empty()) {
+            ++m_firstAvailable;
+        }
+
+        if (m_firstAvailable == m_chunks.size()) {
+            // miss: grow on the hot path, at least doubling the capacity
+            ++m_statistics.m_misses;
+            addChunk(std::max(m_options.m_minChunkSize, m_statistics.m_capacity));
+        }
+
+        Chunk& chunk{ m_chunks[m_firstAvailable] };
+
+        T* object{ chunk.m_free.back() };
+        std::construct_at(object, std::forward<TArgs>(args)...);
+        chunk.m_free.pop_back();
+
+        ++m_statistics.m_acquires;
+        ++m_statistics.m_inUse;
+        m_statistics.m_peakInUse = std::max(m_statistics.m_peakInUse, m_statistics.m_inUse);
+        m_intervalPeak = std::max(m_intervalPeak, m_statistics.m_inUse);
+
+        return PooledPtr<T, TAllocator>{ std::launder(object), PoolDeleter<T, TAllocator>{ this } };
+    }
+
+    template <typename T, typename TAllocator>
+    inline void ObjectPool<T, TAllocator>::maintain(Clock::time_point now)
+    {
+        // acquire rate since the last call
+        const std::chrono::duration<double> elapsed{ now - m_now };
+        if (elapsed.count() > 0.0) {
+            m_statistics.m_acquireRate = (m_statistics.m_acquires - m_acquiresAtMaintain) / elapsed.count();
+        }
+
+        m_now = now;
+        m_acquiresAtMaintain = m_statistics.m_acquires;
+
+        // pre-grow: extrapolate the growth of the peak in-use count for 'lookAhead'
+        const std::size_t growth{ m_intervalPeak > m_lastIntervalPeak ? m_intervalPeak - m_lastIntervalPeak : 0 };
+        const std::size_t trend{ std::min(growth, m_lastGrowth) };
+
+        double predicted{ static_cast<double>(m_intervalPeak) };
+        if (trend > 0 && elapsed.count() > 0.0) {
+            const std::chrono::duration<double> lookAhead{ m_options.m_lookAhead };
+            predicted += trend * lookAhead.count() / elapsed.count();
+        }
+
+        const auto wanted{ static_cast<std::size_t>(predicted * (1.0 + m_options.m_headroom)) };
+
+        if (m_statistics.m_capacity < wanted) {
+            ++m_statistics.m_preGrowths;
+
+            // grow geometrically (by a quarter at least): the number of chunks stays small
+            while (m_statistics.m_capacity < wanted) {
+                addChunk(std::max(wanted - m_statistics.m_capacity, m_statistics.m_capacity / 4));
+            }
+        }
+
+        m_recentPeak = std::max(m_recentPeak, m_intervalPeak);
+        m_lastIntervalPeak = m_intervalPeak;
+        m_lastGrowth = growth;
+        m_intervalPeak = m_statistics.m_inUse;
+
+        // trim: remove idle chunks - newest first - while the remaining capacity
+        // covers the recent peak plus headroom (and the prediction, no growth and trimming in turn)
+        const auto reserve{ std::max(wanted, static_cast<std::size_t>(m_recentPeak * (1.0 + m_options.m_headroom))) };
+
+        for (std::size_t i{ m_chunks.size() }; i-- != 0; ) {
+
+            const Chunk& chunk{ m_chunks[i] };
+
+            if (chunk.m_free.size() != chunk.m_size ||
+                now - chunk.m_idleSince < m_options.m_quietPeriod ||
+                m_statistics.m_capacity - chunk.m_size < reserve)
+            {
+                continue;
+            }
+
+            removeChunk(i);
+            ++m_statistics.m_trims;
+        }
+
+        // start a new quiet period: the peak of the last one is forgotten
+        if (now - m_recentPeakSince >= m_options.m_quietPeriod) {
+            m_recentPeak = m_statistics.m_inUse;
+            m_recentPeakSince = now;
+        }
+    }
+
+    // =======================================================================
+    // private helper methods
+
+    template <typename T, typename TAllocator>
+    inline void ObjectPool<T, TAllocator>::releaseObject(T* object) noexcept
+    {
+        // objects are mostly released in the order they were acquired:
+        // try the chunk of the previous release first
+        std::size_t index{ m_lastReleased };
+        if (std::less<>{}(object, m_lastReleasedBegin) || !std::less<>{}(object, m_lastReleasedEnd)) {
+            index = findChunk(object);
+            m_lastReleased = index;
+            m_lastReleasedBegin = m_chunks[index].m_objects;
+            m_lastReleasedEnd = m_chunks[index].m_objects + m_chunks[index].m_size;
+        }
+
+        Chunk& chunk{ m_chunks[index] };
+
+        std::destroy_at(object);
+        chunk.m_free.push_back(object);   // never reallocates: reserved for the whole chunk
+
+        if (chunk.m_free.size() == chunk.m_size) {
+            chunk.m_idleSince = m_now;    // no clock call on the hot path
+        }
+
+        m_firstAvailable = std::min(m_firstAvailable, index);
+
+        ++m_statistics.m_releases;
+        --m_statistics.m_inUse;
+    }
+
+    template <typename T, typename TAllocator>
+    inline void ObjectPool<T, TAllocator>::addChunk(std::size_t size)
+    {
+        size = std::clamp(size, m_options.m_minChunkSize, m_options.m_maxChunkSize);
+
+        // (care is taken that everything is cleaned up in the event of an exception)
+        m_chunks.reserve(m_chunks.size() + 1);
+        m_byAddress.reserve(m_chunks.size() + 1);
+
+        std::vector<T*> free;
+        free.reserve(size);
+
+        T* objects{ m_allocator.allocate(size) };
+
+        // touch each page of the chunk: the page faults happen here -
+        // not later, when the objects are handed out
+        auto* bytes{ reinterpret_cast<volatile std::byte*>(objects) };
+        for (std::size_t offset{}; offset < size * sizeof(T); offset += PageSize) {
+            bytes[offset] = std::byte{};
+        }
+
+        // the objects are handed out from the lowest address on
+        for (std::size_t i{ size }; i-- != 0; ) {
+            free.push_back(objects + i);
+        }
+
+        m_chunks.push_back(Chunk{ objects, size, std::move(free), m_now });
+
+        const std::size_t index{ m_chunks.size() - 1 };
+        const auto position{ std::upper_bound(m_byAddress.begin(), m_byAddress.end(), objects,
+            [this] (const T* address, std::size_t chunk) { return std::less<>{}(address, m_chunks[chunk].m_objects); }) };
+        m_byAddress.insert(position, index);
+
+        m_firstAvailable = std::min(m_firstAvailable, index);
+
+        m_statistics.m_capacity += size;
+        m_statistics.m_chunks = m_chunks.size();
+    }
+
+    template <typename T, typename TAllocator>
+    inline void ObjectPool<T, TAllocator>::removeChunk(std::size_t index) noexcept
+    {
+        m_allocator.deallocate(m_chunks[index].m_objects, m_chunks[index].m_size);
+
+        m_statistics.m_capacity -= m_chunks[index].m_size;
+
+        m_chunks.erase(m_chunks.begin() + index);
+
+        // the chunks behind the removed one move down by one position
+        std::erase(m_byAddress, index);
+        for (auto& chunk : m_byAddress) {
+            if (chunk > index) {
+                --chunk;
+            }
+        }
+
+        m_firstAvailable = std::min(m_firstAvailable, m_chunks.size());
+        m_lastReleasedBegin = m_lastReleasedEnd = nullptr;
+        m_statistics.m_chunks = m_chunks.size();
+    }
+
+    // the chunk an object belongs to: binary search over the chunk addresses
+    template <typename T, typename TAllocator>
+    inline std::size_t ObjectPool<T, TAllocator>::findChunk(const T* object) const noexcept
+    {
+        const auto position{ std::upper_bound(m_byAddress.begin(), m_byAddress.end(), object,
+            [this] (const T* address, std::size_t chunk) { return std::less<>{}(address, m_chunks[chunk].m_objects); }) };
+
+        assert(position != m_byAddress.begin());
+        return *std::prev(position);
+    }
+
+    // =======================================================================
+    // PoolDeleter
+
+    template <typename T, typename TAllocator>
+    inline void PoolDeleter<T, TAllocator>::operator()(T* object) const noexcept
+    {
+        m_pool->releaseObject(object);
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
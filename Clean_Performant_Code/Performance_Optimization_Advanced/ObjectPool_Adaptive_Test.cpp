@@ -0,0 +1,209 @@
+// ===========================================================================
+// ObjectPool_Adaptive_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../Person/Person.h"
+
+#include "ObjectPool_Adaptive.h"
+#include "ObjectPool_DynamicSize.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <vector>
+
+namespace ObjectPool_Adaptive_SimpleTest {
+
+    using namespace AdaptiveObjectPool;
+
+    static void printStatistics(const PoolStatistics& statistics)
+    {
+        std::println("Acquires: {} - Releases: {} - In use: {} (peak {}) - Capacity: {} in {} chunks",
+            statistics.m_acquires, statistics.m_releases, statistics.m_inUse, statistics.m_peakInUse,
+            statistics.m_capacity, statistics.m_chunks);
+
+        std::println("Misses: {} - Pre-growths: {} - Trims: {} - Acquire rate: {:.0f}/s",
+            statistics.m_misses, statistics.m_preGrowths, statistics.m_trims, statistics.m_acquireRate);
+    }
+
+    static void main_object_pool_adaptive_01()
+    {
+        ObjectPool<Person> pool{ PoolOptions{ .m_initialCapacity = 4, .m_minChunkSize = 4 } };
+
+        {
+            auto hans{ pool.acquireObject("Hans", "Mueller", static_cast<size_t>(30)) };
+            auto susi{ pool.acquireObject("Susi", "Wagner", static_cast<size_t>(40)) };
+
+            std::println("{} {} has age {}", hans->getFirstname(), hans->getLastname(), hans->getAge());
+            std::println("{} {} has age {}", susi->getFirstname(), susi->getLastname(), susi->getAge());
+        }
+
+        printStatistics(pool.statistics());
+    }
+
+    // load phases on a simulated clock (one tick = 10 milliseconds):
+    // ramp up, steady load, quiet phase (the pool trims), second burst (the pool pre-grows)
+    static void main_object_pool_adaptive_02()
+    {
+        using namespace std::chrono_literals;
+
+        ObjectPool<int> pool{ PoolOptions{ .m_lookAhead = 50ms, .m_quietPeriod = 500ms } };
+
+        std::vector<PooledPtr<int>> objects;
+
+        auto now{ Clock::now() };
+
+        auto load = [] (int tick) -> std::size_t {
+            if (tick < 20)  return 500 * tick;        // ramp up
+            if (tick < 60)  return 10'000;            // steady
+            if (tick < 200) return 200;               // quiet
+            return 200 + 1'000 * (tick - 200);        // second burst
+        };
+
+        std::println("{:>6}{:>10}{:>10}{:>8}{:>8}{:>12}{:>8}", "Tick", "In use", "Capacity", "Chunks", "Misses", "Pre-growths", "Trims");
+
+        for (int tick{}; tick != 210; ++tick) {
+
+            const std::size_t wanted{ load(tick) };
+
+            while (objects.size() < wanted) {
+                objects.push_back(pool.acquireObject(tick));
+            }
+            objects.resize(std::min(objects.size(), wanted));
+
+            now += 10ms;
+            pool.maintain(now);
+
+            if (tick % 10 == 9) {
+                const auto& statistics{ pool.statistics() };
+                std::println("{:>6}{:>10}{:>10}{:>8}{:>8}{:>12}{:>8}", tick, statistics.m_inUse, statistics.m_capacity,
+                    statistics.m_chunks, statistics.m_misses, statistics.m_preGrowths, statistics.m_trims);
+            }
+        }
+
+        objects.clear();
+        printStatistics(pool.statistics());
+    }
+}
+
+namespace ObjectPool_Adaptive_Benchmark {
+
+#ifdef _DEBUG
+    static constexpr std::size_t Frames = 100;        // debug
+#else
+    static constexpr std::size_t Frames = 1'000;      // release
+#endif
+
+    struct Particle
+    {
+        double m_x, m_y, m_z;
+        double m_mass;
+    };
+
+    // Load profile: the number of objects needed per frame ramps up
+    // in the first half of the frames, then it drops to a tenth
+    static std::size_t load(std::size_t frame)
+    {
+        return (frame < Frames / 2) ? 1'000 + 200 * frame : 10'000;
+    }
+
+    // each frame acquires 'load' objects, which die at the end of the frame:
+    // the worst frame (time per object) shows the growth on the hot path.
+    // 'maintain' gets the time on a simulated clock, one frame = 16 milliseconds
+    template <typename TAcquire, typename TMaintain>
+    static void runFrames(TAcquire acquire, TMaintain maintain)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+        Clock::duration total{}, housekeeping{};
+        Nanoseconds worst{};
+        Clock::time_point frameTime{ Clock::now() };
+
+        for (std::size_t frame{}; frame != Frames; ++frame) {
+
+            const auto begin{ Clock::now() };
+            acquire(load(frame));
+            const auto end{ Clock::now() };
+
+            total += end - begin;
+            worst = std::max(worst, Nanoseconds{ end - begin } / load(frame));
+
+            frameTime += std::chrono::milliseconds{ 16 };
+
+            const auto beginMaintain{ Clock::now() };
+            maintain(frameTime);
+            housekeeping += Clock::now() - beginMaintain;
+        }
+
+        using Microseconds = std::chrono::duration<double, std::micro>;
+
+        std::println("Average frame: {:8.1f} us - worst frame: {:6.1f} ns per object - housekeeping: {:8.1f} us",
+            Microseconds{ total }.count() / Frames, worst.count(), Microseconds{ housekeeping }.count());
+    }
+
+    static void main_object_pool_adaptive_20()
+    {
+        std::println("DynamicSizeObjectPool (doubling on demand) ...");
+        {
+            DynamicSizeObjectPool::ObjectPool<Particle> pool;
+            std::vector<DynamicSizeObjectPool::PooledPtr<Particle>> particles;
+            particles.reserve(load(Frames / 2 - 1));
+
+            runFrames(
+                [&] (std::size_t count) {
+                    for (std::size_t i{}; i != count; ++i) {
+                        particles.push_back(pool.acquireObject(1.0, 2.0, 3.0, 4.0));
+                    }
+                    particles.clear();
+                },
+                [] (auto) {}
+            );
+
+            // the capacity of the pool is the sum of all chunks - it never shrinks
+            std::size_t capacity{};
+            for (std::size_t chunk{ 2 }; capacity < load(Frames / 2 - 1); chunk *= 2) {
+                capacity += chunk;
+            }
+            std::println("Capacity: {}", capacity);
+        }
+
+        // without and with an initial capacity, that covers the first frame
+        for (std::size_t initialCapacity : { std::size_t{ 0 }, load(0) }) {
+
+            std::println("AdaptiveObjectPool (pre-growing and trimming in maintain, initial capacity {}) ...", initialCapacity);
+
+            AdaptiveObjectPool::ObjectPool<Particle> pool{ AdaptiveObjectPool::PoolOptions{ .m_initialCapacity = initialCapacity } };
+            std::vector<AdaptiveObjectPool::PooledPtr<Particle>> particles;
+            particles.reserve(load(Frames / 2 - 1));
+
+            runFrames(
+                [&] (std::size_t count) {
+                    for (std::size_t i{}; i != count; ++i) {
+                        particles.push_back(pool.acquireObject(1.0, 2.0, 3.0, 4.0));
+                    }
+                    particles.clear();
+                },
+                [&] (auto now) { pool.maintain(now); }
+            );
+
+            const auto& statistics{ pool.statistics() };
+            std::println("Capacity: {} - Peak in use: {} - Misses: {} - Pre-growths: {} - Trims: {}",
+                statistics.m_capacity, statistics.m_peakInUse, statistics.m_misses, statistics.m_preGrowths, statistics.m_trims);
+        }
+    }
+}
+
+void main_object_pool_adaptive()
+{
+    ObjectPool_Adaptive_SimpleTest::main_object_pool_adaptive_01();
+    ObjectPool_Adaptive_SimpleTest::main_object_pool_adaptive_02();
+
+    ObjectPool_Adaptive_Benchmark::main_object_pool_adaptive_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
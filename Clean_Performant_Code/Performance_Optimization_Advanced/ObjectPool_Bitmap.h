@@ -0,0 +1,247 @@
+// ===========================================================================
+// ObjectPool_Bitmap.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BITMAP_OBJECT_POOL_SSE2
+#endif
+
+namespace BitmapObjectPool {
+
+    // Fixed-size object pool with an occupancy bitmap instead of a free list:
+    //
+    //  * Bit i of the bitmap is set, if block i is in use. allocate() looks for
+    //    the first word with a zero bit and takes its lowest zero bit
+    //    (std::countr_one), deallocate() clears the bit again.
+    //
+    //  * The free blocks are never written to, and all bookkeeping lives
+    //    in the (small) bitmap - not scattered across the storage.
+    //
+    //  * for_each_live() visits all objects in use in address order,
+    //    which makes bulk processing of all pooled objects cache friendly.
+
+    template<class T, size_t Size = 64>
+    class ObjectPool final
+    {
+        static_assert(Size > 0, "Size must be greater than zero!");
+
+    public:
+        using value_type = T;
+
+        // c'tor/d'tor
+        ObjectPool();
+        ~ObjectPool();
+
+        // no copy / no move
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator =(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&& other) noexcept = delete;
+        ObjectPool& operator= (ObjectPool&& other) noexcept = delete;
+
+        [[nodiscard]] T* allocate();
+        void deallocate(T* p) noexcept;
+
+        template<typename ...TArgs>
+        [[nodiscard]] T* construct(TArgs&& ...args);
+        void destroy(T* p) noexcept;
+
+        // calls 'func' for each allocated block, in address order
+        template <typename TFunc>
+        void for_each_live(TFunc&& func);
+
+        template <typename TFunc>
+        void for_each_live(TFunc&& func) const;
+
+        size_t size() const noexcept { return Size; }
+        size_t capacity() const noexcept { return Size - m_used; }
+        bool contains(const T* p) const noexcept;
+
+    private:
+        static constexpr size_t BitsPerWord{ 64 };
+        static constexpr size_t Words{ (Size + BitsPerWord - 1) / BitsPerWord };
+
+        // bits beyond 'Size' in the last word are permanently "in use"
+        static constexpr std::uint64_t PaddingBits{
+            (Size % BitsPerWord == 0) ? 0 : ~std::uint64_t{} << (Size % BitsPerWord)
+        };
+
+        // private helper methods
+        size_t findWord(size_t first) const noexcept;
+
+        T* block(size_t index) const noexcept { return m_storage + index; }
+
+        // member data
+        T*                                m_storage;
+        std::array<std::uint64_t, Words>  m_bitmap;
+        size_t                            m_used;
+        size_t                            m_firstFreeWord;   // no word before this one has a zero bit
+    };
+
+    // =======================================================================
+    // c'tor/d'tor
+
+    template <typename T, size_t Size>
+    inline ObjectPool<T, Size>::ObjectPool()
+        : m_storage{ nullptr }, m_bitmap{}, m_used{}, m_firstFreeWord{}
+    {
+        m_storage = static_cast<T*>(::operator new(Size * sizeof(T), std::align_val_t{ alignof(T) }));
+
+        m_bitmap[Words - 1] = PaddingBits;
+    }
+
+    template <typename T, size_t Size>
+    inline ObjectPool<T, Size>::~ObjectPool()
+    {
+        // Note: like all pools in this project, the pool does not destroy objects
+        //       still in use - it just releases the memory.
+        ::operator delete(m_storage, std::align_val_t{ alignof(T) });
+    }
+
+    // =======================================================================
+    // public interface
+
+    template <typename T, size_t Size>
+    [[nodiscard]] inline T* ObjectPool<T, Size>::allocate()
+    {
+        const size_t word{ findWord(m_firstFreeWord) };
+
+        if (word == Words) {
+            m_firstFreeWord = Words;
+            throw std::bad_alloc{};
+        }
+
+        const size_t bit{ static_cast<size_t>(std::countr_one(m_bitmap[word])) };
+        m_bitmap[word] |= std::uint64_t{ 1 } << bit;
+
+        m_firstFreeWord = word;
+        ++m_used;
+
+        return block(word * BitsPerWord + bit);
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::deallocate(T* ptr) noexcept
+    {
+        const size_t index{ static_cast<size_t>(ptr - m_storage) };
+        const size_t word{ index / BitsPerWord };
+
+        m_bitmap[word] &= ~(std::uint64_t{ 1 } << (index % BitsPerWord));
+
+        m_firstFreeWord = std::min(m_firstFreeWord, word);
+        --m_used;
+    }
+
+    template <typename T, size_t Size>
+    template<typename ...TArgs>
+    [[nodiscard]] inline T* ObjectPool<T, Size>::construct(TArgs&& ...args)
+    {
+        T* ptr = allocate();
+
+        try {
+            std::construct_at(ptr, std::forward<TArgs>(args)...);
+        }
+        catch (...) {
+            deallocate(ptr);
+            throw;
+        }
+
+        return ptr;
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::destroy(T* ptr) noexcept
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+
+        std::destroy_at(ptr);
+        deallocate(ptr);
+    }
+
+    template <typename T, size_t Size>
+    template <typename TFunc>
+    inline void ObjectPool<T, Size>::for_each_live(TFunc&& func)
+    {
+        for (size_t word{}; word != Words; ++word) {
+
+            std::uint64_t bits{ m_bitmap[word] };
+            if (word == Words - 1) {
+                bits &= ~PaddingBits;
+            }
+
+            // visit the set bits from the lowest to the highest one
+            while (bits != 0) {
+                const size_t bit{ static_cast<size_t>(std::countr_zero(bits)) };
+                bits &= bits - 1;
+                func(*std::launder(block(word * BitsPerWord + bit)));
+            }
+        }
+    }
+
+    template <typename T, size_t Size>
+    template <typename TFunc>
+    inline void ObjectPool<T, Size>::for_each_live(TFunc&& func) const
+    {
+        const_cast<ObjectPool*>(this)->for_each_live([&] (const T& object) { func(object); });
+    }
+
+    template <typename T, size_t Size>
+    inline bool ObjectPool<T, Size>::contains(const T* ptr) const noexcept
+    {
+        if (ptr < m_storage || ptr >= m_storage + Size) {
+            return false;
+        }
+
+        const size_t index{ static_cast<size_t>(ptr - m_storage) };
+        return (m_bitmap[index / BitsPerWord] >> (index % BitsPerWord) & 1) != 0;
+    }
+
+    // =======================================================================
+    // private helper methods
+
+    // returns the index of the first word at or after 'first', that has a zero bit - or 'Words'
+    template <typename T, size_t Size>
+    inline size_t ObjectPool<T, Size>::findWord(size_t first) const noexcept
+    {
+        size_t word{ first };
+
+#if defined(BITMAP_OBJECT_POOL_SSE2)
+        // large pools: test two words with a single comparison
+        if constexpr (Words >= 8) {
+            const __m128i allOnes{ _mm_set1_epi32(-1) };
+
+            for (; word + 2 <= Words; word += 2) {
+                const __m128i bits{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_bitmap[word])) };
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(bits, allOnes)) != 0xFFFF) {
+                    break;
+                }
+            }
+        }
+#endif
+
+        for (; word != Words; ++word) {
+            if (m_bitmap[word] != ~std::uint64_t{}) {
+                return word;
+            }
+        }
+
+        return Words;
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,173 @@
+// ===========================================================================
+// ObjectPool_Bitmap_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+#include "../Person/Person.h"
+
+#include "ObjectPool_Bitmap.h"
+#include "ObjectPool_FixedSize.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <print>
+#include <random>
+#include <vector>
+
+namespace ObjectPool_Bitmap_SimpleTest {
+
+    using namespace BitmapObjectPool;
+
+    static void main_object_pool_bitmap_01()
+    {
+        ObjectPool<Person, 4> pool;
+
+        auto ptr1 = pool.construct("Hans", "Mueller", static_cast<size_t>(30));
+        auto ptr2 = pool.construct("Susi", "Wagner", static_cast<size_t>(40));
+        auto ptr3 = pool.construct("Gerd", "Meier", static_cast<size_t>(50));
+
+        // free a block in the middle - the next allocation reuses it
+        pool.destroy(ptr2);
+        ptr2 = pool.construct("Sepp", "Huber", static_cast<size_t>(60));
+
+        pool.for_each_live([] (const Person& person) {
+            std::println("{} {} has age {}", person.getFirstname(), person.getLastname(), person.getAge());
+        });
+
+        std::println("Size: {} - Capacity: {}", pool.size(), pool.capacity());
+
+        pool.destroy(ptr1);
+        pool.destroy(ptr2);
+        pool.destroy(ptr3);
+    }
+
+    static void main_object_pool_bitmap_02()
+    {
+        // 'Size' doesn't have to be a multiple of 64
+        ObjectPool<int, 100> pool;
+
+        std::vector<int*> pointers;
+        while (pool.capacity() != 0) {
+            pointers.push_back(pool.construct(static_cast<int>(pointers.size())));
+        }
+
+        try {
+            [[maybe_unused]] auto ptr = pool.construct(-1);
+        }
+        catch (const std::bad_alloc&) {
+            std::println("Pool exhausted after {} objects", pointers.size());
+        }
+
+        // release every third object
+        for (std::size_t i{}; i < pointers.size(); i += 3) {
+            pool.destroy(pointers[i]);
+        }
+
+        int sum{};
+        std::size_t count{};
+        pool.for_each_live([&] (int value) { sum += value; ++count; });
+
+        std::println("Live objects: {} - Sum: {}", count, sum);
+    }
+}
+
+namespace ObjectPool_Bitmap_Benchmark {
+
+#ifdef _DEBUG
+    static constexpr std::size_t Ticks = 20;          // debug
+#else
+    static constexpr std::size_t Ticks = 200;         // release
+#endif
+
+    static constexpr std::size_t Size = 1'024 * 1'024;
+    static constexpr std::size_t Live = Size / 2;
+    static constexpr std::size_t Churn = Live / 10;
+
+    struct Particle
+    {
+        float m_x, m_y, m_z;
+        float m_vx, m_vy, m_vz;
+    };
+
+    // Simulation tick: all live particles are updated, then some of them
+    // die and are replaced by new ones. The free-list pool needs a separate
+    // list of the live objects: dead entries are removed by swap-and-pop,
+    // new ones are appended - the list soon is in random address order.
+    template <typename TPool, typename TForEach>
+    static void simulate(TPool& pool, TForEach forEachLive)
+    {
+        std::vector<Particle*> live;
+        std::mt19937 generator{ 42 };
+
+        for (std::size_t i{}; i != Live; ++i) {
+            live.push_back(pool.construct(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f));
+        }
+
+        auto update = [] (Particle& particle) {
+            particle.m_x += particle.m_vx;
+            particle.m_y += particle.m_vy;
+            particle.m_z += particle.m_vz;
+        };
+
+        ScopedTimer watch{};
+
+        for (std::size_t tick{}; tick != Ticks; ++tick) {
+
+            forEachLive(live, update);
+
+            for (std::size_t i{}; i != Churn; ++i) {
+                std::uniform_int_distribution<std::size_t> distribution{ 0, live.size() - 1 };
+                auto& victim{ live[distribution(generator)] };
+                pool.destroy(victim);
+                victim = live.back();
+                live.pop_back();
+            }
+
+            for (std::size_t i{}; i != Churn; ++i) {
+                live.push_back(pool.construct(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f));
+            }
+        }
+
+        for (auto* particle : live) {
+            pool.destroy(particle);
+        }
+    }
+
+    static void main_object_pool_bitmap_20()
+    {
+        std::println("Simulation: {} ticks, {} live particles, {} replaced per tick", Ticks, Live, Churn);
+
+        std::println("Free list pool - iterating the list of live objects ...");
+        {
+            auto pool{ std::make_unique<FixedSizeObjectPool::ObjectPool<Particle, Size>>() };
+
+            simulate(*pool, [] (auto& live, auto func) {
+                for (auto* particle : live) {
+                    func(*particle);
+                }
+            });
+        }
+
+        std::println("Bitmap pool - for_each_live (address order) ...");
+        {
+            auto pool{ std::make_unique<BitmapObjectPool::ObjectPool<Particle, Size>>() };
+
+            simulate(*pool, [&] (auto&, auto func) {
+                pool->for_each_live(func);
+            });
+        }
+    }
+}
+
+void main_object_pool_bitmap()
+{
+    ObjectPool_Bitmap_SimpleTest::main_object_pool_bitmap_01();
+    ObjectPool_Bitmap_SimpleTest::main_object_pool_bitmap_02();
+
+    ObjectPool_Bitmap_Benchmark::main_object_pool_bitmap_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
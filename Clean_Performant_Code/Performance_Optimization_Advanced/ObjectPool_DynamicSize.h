@@ -5,13 +5,99 @@
 #pragma once
 
 #include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
 #include <memory>
 #include <numeric>
 #include <print>
+#include <utility>
 #include <vector>
 
 namespace DynamicSizeObjectPool {
 
+    template <typename T, typename TAllocator>
+    class ObjectPool;
+
+    // =======================================================================
+    // deleter of a PooledPtr: returns the object to its pool
+
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class PoolDeleter
+    {
+    public:
+        PoolDeleter() noexcept = default;
+        explicit PoolDeleter(ObjectPool<T, TAllocator>* pool) noexcept : m_pool{ pool } {}
+
+        void operator()(T* object) const noexcept;
+
+    private:
+        ObjectPool<T, TAllocator>* m_pool{ nullptr };
+    };
+
+    // move-only handle of a pooled object - no control block, no atomic reference count
+    template <typename T, typename TAllocator = std::allocator<T>>
+    using PooledPtr = std::unique_ptr<T, PoolDeleter<T, TAllocator>>;
+
+    // =======================================================================
+    // base class for objects with shared ownership (intrusive reference count):
+    // ObjectPool<T>::acquireShared is available for types derived from RefCounted
+
+    class RefCounted
+    {
+    public:
+        RefCounted() noexcept = default;
+
+        // the reference count belongs to the object's identity, not to its value
+        RefCounted(const RefCounted&) noexcept {}
+        RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+
+        std::size_t useCount() const noexcept { return m_refCount; }
+
+    private:
+        template <typename T, typename TAllocator>
+        friend class SharedPooledPtr;
+
+        std::size_t m_refCount{ 0 };
+    };
+
+    // copyable handle of a pooled object: the reference count lives in the object itself.
+    // Like the pool it is not thread-safe - the count is not atomic.
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class SharedPooledPtr
+    {
+    public:
+        // c'tor/d'tor
+        SharedPooledPtr() noexcept = default;
+        ~SharedPooledPtr() { reset(); }
+
+        // copy and move
+        SharedPooledPtr(const SharedPooledPtr& other) noexcept;
+        SharedPooledPtr& operator=(const SharedPooledPtr& other) noexcept;
+        SharedPooledPtr(SharedPooledPtr&& other) noexcept;
+        SharedPooledPtr& operator=(SharedPooledPtr&& other) noexcept;
+
+        // public interface
+        void reset() noexcept;
+
+        T* get() const noexcept { return m_object; }
+        T& operator*() const noexcept { return *m_object; }
+        T* operator->() const noexcept { return m_object; }
+        explicit operator bool() const noexcept { return m_object != nullptr; }
+
+        std::size_t useCount() const noexcept;
+
+    private:
+        friend class ObjectPool<T, TAllocator>;
+
+        SharedPooledPtr(T* object, ObjectPool<T, TAllocator>* pool) noexcept;
+
+        T*                         m_object{ nullptr };
+        ObjectPool<T, TAllocator>* m_pool{ nullptr };
+    };
+
+    // =======================================================================
+
     template <typename T, typename TAllocator = std::allocator<T>>
     class ObjectPool final
     {
@@ -37,10 +123,25 @@ namespace DynamicSizeObjectPool {
 
         // reserves and returns an object from the pool
         template <typename ... TArgs>
-        std::shared_ptr<T> acquireObject(TArgs&&... args);
+        PooledPtr<T, TAllocator> acquireObject(TArgs&&... args);
+
+        // same as acquireObject, but with shared ownership (intrusive reference count)
+        template <typename ... TArgs>
+            requires std::derived_from<T, RefCounted>
+        SharedPooledPtr<T, TAllocator> acquireShared(TArgs&&... args);
+
+        // reserves 'count' objects at once, each one is constructed with 'args'
+        template <typename ... TArgs>
+        std::vector<PooledPtr<T, TAllocator>> acquireMany(std::size_t count, const TArgs&... args);
 
     private:
+        friend class PoolDeleter<T, TAllocator>;
+        friend class SharedPooledPtr<T, TAllocator>;
+
         // private helper methods
+        template <typename ... TArgs>
+        T* constructObject(TArgs&&... args);
+        void releaseObject(T* object) noexcept;
         void addChunk();
 
         // member data
@@ -50,6 +151,9 @@ namespace DynamicSizeObjectPool {
         TAllocator       m_allocator;
     };
 
+    // =======================================================================
+    // ObjectPool
+
     template <typename T, typename TAllocator>
     inline ObjectPool<T, TAllocator>::ObjectPool()
         : m_currentChunkSize{ InitialChunkSize }
@@ -81,7 +185,47 @@ namespace DynamicSizeObjectPool {
 
     template <typename T, typename TAllocator>
     template <typename... TArgs>
-    inline std::shared_ptr<T> ObjectPool<T, TAllocator>::acquireObject(TArgs&& ... args)
+    inline PooledPtr<T, TAllocator> ObjectPool<T, TAllocator>::acquireObject(TArgs&& ... args)
+    {
+        T* object{ constructObject(std::forward<TArgs>(args)...) };
+
+        // wrap the constructed object and return it: the deleter
+        // just holds a pointer to this pool, nothing is allocated
+        return PooledPtr<T, TAllocator>{ object, PoolDeleter<T, TAllocator>{ this } };
+    }
+
+    template <typename T, typename TAllocator>
+    template <typename... TArgs>
+        requires std::derived_from<T, RefCounted>
+    inline SharedPooledPtr<T, TAllocator> ObjectPool<T, TAllocator>::acquireShared(TArgs&& ... args)
+    {
+        T* object{ constructObject(std::forward<TArgs>(args)...) };
+        return SharedPooledPtr<T, TAllocator>{ object, this };
+    }
+
+    template <typename T, typename TAllocator>
+    template <typename... TArgs>
+    inline std::vector<PooledPtr<T, TAllocator>> ObjectPool<T, TAllocator>::acquireMany(std::size_t count, const TArgs& ... args)
+    {
+        // make room for the whole batch up front
+        while (m_freeObjects.size() < count) {
+            addChunk();
+        }
+
+        std::vector<PooledPtr<T, TAllocator>> objects;
+        objects.reserve(count);
+
+        for (std::size_t i{}; i != count; ++i) {
+            // if a c'tor throws, the objects constructed so far are returned by 'objects'
+            objects.emplace_back(constructObject(args...), PoolDeleter<T, TAllocator>{ this });
+        }
+
+        return objects;
+    }
+
+    template <typename T, typename TAllocator>
+    template <typename... TArgs>
+    inline T* ObjectPool<T, TAllocator>::constructObject(TArgs&& ... args)
     {
         // if there are no free objects, need to allocate a new chunk
         if (m_freeObjects.empty()) {
@@ -104,14 +248,14 @@ namespace DynamicSizeObjectPool {
         // remove the object from the list of free objects
         m_freeObjects.pop_back();
 
-        // wrap the constructed object and return it
-        return std::shared_ptr<T>{
-            constructedObject,
-            [this](T* object) {
-                std::destroy_at(object);          // destroy object
-                m_freeObjects.push_back(object);  // put object back in the list of free objects.
-            }
-        };
+        return constructedObject;
+    }
+
+    template <typename T, typename TAllocator>
+    inline void ObjectPool<T, TAllocator>::releaseObject(T* object) noexcept
+    {
+        std::destroy_at(object);          // destroy object
+        m_freeObjects.push_back(object);  // put object back in the list of free objects (never reallocates, see addChunk)
     }
 
     template <typename T, typename TAllocator>
@@ -131,6 +275,18 @@ namespace DynamicSizeObjectPool {
             throw;
         }
 
+        // The list of free objects must be able to hold all objects of all chunks:
+        // releasing an object (in a noexcept deleter) must never reallocate it.
+        // The chunks hold InitialChunkSize * (1 + 2 + ... + m_currentChunkSize / InitialChunkSize) objects.
+        try {
+            m_freeObjects.reserve(2 * m_currentChunkSize - InitialChunkSize);
+        }
+        catch (...) {
+            m_allocator.deallocate(m_pool.back(), m_currentChunkSize);
+            m_pool.pop_back();
+            throw;
+        }
+
         // Create pointers to each individual object in the new chunk
         // and store them in the list of free objects.
         // This list is normally always empty;
@@ -154,6 +310,79 @@ namespace DynamicSizeObjectPool {
         // double the chunk size for next time
         m_currentChunkSize *= 2;
     }
+
+    // =======================================================================
+    // PoolDeleter
+
+    template <typename T, typename TAllocator>
+    inline void PoolDeleter<T, TAllocator>::operator()(T* object) const noexcept
+    {
+        m_pool->releaseObject(object);
+    }
+
+    // =======================================================================
+    // SharedPooledPtr
+
+    template <typename T, typename TAllocator>
+    inline SharedPooledPtr<T, TAllocator>::SharedPooledPtr(T* object, ObjectPool<T, TAllocator>* pool) noexcept
+        : m_object{ object }, m_pool{ pool }
+    {
+        m_object->RefCounted::m_refCount = 1;
+    }
+
+    template <typename T, typename TAllocator>
+    inline SharedPooledPtr<T, TAllocator>::SharedPooledPtr(const SharedPooledPtr& other) noexcept
+        : m_object{ other.m_object }, m_pool{ other.m_pool }
+    {
+        if (m_object != nullptr) {
+            ++m_object->RefCounted::m_refCount;
+        }
+    }
+
+    template <typename T, typename TAllocator>
+    inline SharedPooledPtr<T, TAllocator>& SharedPooledPtr<T, TAllocator>::operator=(const SharedPooledPtr& other) noexcept
+    {
+        SharedPooledPtr copy{ other };
+        std::swap(m_object, copy.m_object);
+        std::swap(m_pool, copy.m_pool);
+        return *this;
+    }
+
+    template <typename T, typename TAllocator>
+    inline SharedPooledPtr<T, TAllocator>::SharedPooledPtr(SharedPooledPtr&& other) noexcept
+        : m_object{ std::exchange(other.m_object, nullptr) },
+          m_pool{ std::exchange(other.m_pool, nullptr) }
+    {
+    }
+
+    template <typename T, typename TAllocator>
+    inline SharedPooledPtr<T, TAllocator>& SharedPooledPtr<T, TAllocator>::operator=(SharedPooledPtr&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            m_object = std::exchange(other.m_object, nullptr);
+            m_pool = std::exchange(other.m_pool, nullptr);
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename TAllocator>
+    inline void SharedPooledPtr<T, TAllocator>::reset() noexcept
+    {
+        if (m_object != nullptr && --m_object->RefCounted::m_refCount == 0) {
+            m_pool->releaseObject(m_object);
+        }
+
+        m_object = nullptr;
+        m_pool = nullptr;
+    }
+
+    template <typename T, typename TAllocator>
+    inline std::size_t SharedPooledPtr<T, TAllocator>::useCount() const noexcept
+    {
+        return (m_object != nullptr) ? m_object->RefCounted::m_refCount : 0;
+    }
 }
 
 
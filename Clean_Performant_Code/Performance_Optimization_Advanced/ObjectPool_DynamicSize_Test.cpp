@@ -8,8 +8,11 @@
 #include "ObjectPool_DynamicSize.h"
 
 #include <array>
+#include <cstddef>
 #include <memory>
 #include <print>
+#include <string>
+#include <vector>
 
 namespace ObjectPool_DynamicSize_SimpleTest {
 
@@ -51,9 +54,45 @@ namespace ObjectPool_DynamicSize_SimpleTest {
         std::println("Done.");
 
         // Note:
-        // 3 std::shared:ptr objects are going out of scope,
+        // 3 PooledPtr objects are going out of scope,
         // the according objects are put back in the list of free objects.
     }
+
+    // objects with shared ownership: the reference count lives in the object
+    class Document : public RefCounted
+    {
+    public:
+        explicit Document(std::string title) : m_title{ std::move(title) } {}
+
+        const std::string& getTitle() const { return m_title; }
+
+    private:
+        std::string m_title;
+    };
+
+    static void main_object_pool_03()
+    {
+        ObjectPool<Document> pool{};
+
+        auto document{ pool.acquireShared("Report") };
+        {
+            auto copy{ document };
+            std::println("{}: use count {}", copy->getTitle(), document.useCount());
+        }
+
+        std::println("{}: use count {}", document->getTitle(), document.useCount());
+    }
+
+    static void main_object_pool_04()
+    {
+        ObjectPool<Person> pool{};
+
+        // all chunks needed for the batch are allocated up front
+        auto persons{ pool.acquireMany(10, "Sepp", "Mueller", (size_t) 30) };
+
+        std::println("Acquired {} persons, first one is {} {}",
+            persons.size(), persons.front()->getFirstname(), persons.front()->getLastname());
+    }
 }
 
 namespace ObjectPool_DynamicSize_AdvancedTest {
@@ -75,7 +114,7 @@ namespace ObjectPool_DynamicSize_AdvancedTest {
             ScopedTimer watch{};
 
             for (size_t i{ 0 }; i < Iterations; ++i) {
-                auto ptr = pool.acquireObject(i);         // std::shared_ptr ... goes immediately out of scope
+                auto ptr = pool.acquireObject(i);         // PooledPtr ... goes immediately out of scope
             }
         }
 
@@ -104,7 +143,7 @@ namespace ObjectPool_DynamicSize_AdvancedTest {
             ScopedTimer watch{};
 
             for (size_t i{ 0 }; i < Iterations; ++i) {
-                auto ptr = pool.acquireObject(Person{ "Hans", "Mueller", 30 });         // std::shared_ptr ... goes immediately out of scope
+                auto ptr = pool.acquireObject(Person{ "Hans", "Mueller", 30 });         // PooledPtr ... goes immediately out of scope
             }
         }
 
@@ -136,7 +175,7 @@ namespace ObjectPool_DynamicSize_AdvancedTest {
 
     using MyPool = ObjectPool<ExpensiveObject>;
 
-    static std::shared_ptr<ExpensiveObject> getExpensiveObject(MyPool& pool)
+    static PooledPtr<ExpensiveObject> getExpensiveObject(MyPool& pool)
     {
         // obtain an ExpensiveObject object from the pool.
         auto object{ pool.acquireObject() };
@@ -190,12 +229,12 @@ namespace ObjectPool_DynamicSize_AdvancedTest {
 
             ScopedTimer watch{};
 
-            std::vector<std::shared_ptr<ExpensiveObject>> listObjectsPool;
+            std::vector<PooledPtr<ExpensiveObject>> listObjectsPool;
 
             for (size_t i{ 0 }; i < NumberOfIterations; ++i) {
                 auto object{ getExpensiveObject(pool) };
                 processExpensiveObject(*object.get());
-                listObjectsPool.push_back(object);
+                listObjectsPool.push_back(std::move(object));
             }
 
             std::println("Done");
@@ -220,15 +259,110 @@ namespace ObjectPool_DynamicSize_AdvancedTest {
     }
 }
 
+namespace ObjectPool_DynamicSize_Benchmark {
+
+    using namespace DynamicSizeObjectPool;
+
+#ifdef _DEBUG
+    static constexpr std::size_t Iterations = 1'000'000;      // debug
+#else
+    static constexpr std::size_t Iterations = 10'000'000;     // release
+#endif
+
+    static constexpr std::size_t Batch = 64;
+
+    struct Particle : public RefCounted
+    {
+        Particle(double x, double y, double z) : m_x{ x }, m_y{ y }, m_z{ z } {}
+
+        double m_x, m_y, m_z;
+    };
+
+    // acquire/release throughput of the different handles:
+    // acquireObject hands out a PooledPtr (std::unique_ptr, the deleter is a pool pointer).
+    // The former std::shared_ptr path is emulated by converting the PooledPtr into
+    // a std::shared_ptr - which allocates a control block per object, like before.
+    static void main_object_pool_20()
+    {
+        ObjectPool<Particle> pool;
+
+        std::println("PooledPtr: acquire / release ...");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                auto ptr{ pool.acquireObject(1.0, 2.0, 3.0) };
+            }
+        }
+
+        std::println("std::shared_ptr: acquire / release ...");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                std::shared_ptr<Particle> ptr{ pool.acquireObject(1.0, 2.0, 3.0) };
+            }
+        }
+
+        std::println("SharedPooledPtr: acquire / copy / release ...");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                auto ptr{ pool.acquireShared(1.0, 2.0, 3.0) };
+                auto copy{ ptr };
+            }
+        }
+
+        std::println("std::shared_ptr: acquire / copy / release ...");
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations; ++i) {
+                std::shared_ptr<Particle> ptr{ pool.acquireObject(1.0, 2.0, 3.0) };
+                auto copy{ ptr };
+            }
+        }
+
+        std::println("acquireMany: batches of {} objects ...", Batch);
+        {
+            ScopedTimer watch{};
+
+            for (std::size_t i{}; i != Iterations / Batch; ++i) {
+                auto particles{ pool.acquireMany(Batch, 1.0, 2.0, 3.0) };
+            }
+        }
+
+        std::println("acquireObject: batches of {} objects ...", Batch);
+        {
+            ScopedTimer watch{};
+
+            std::vector<PooledPtr<Particle>> particles;
+            particles.reserve(Batch);
+
+            for (std::size_t i{}; i != Iterations / Batch; ++i) {
+                for (std::size_t j{}; j != Batch; ++j) {
+                    particles.push_back(pool.acquireObject(1.0, 2.0, 3.0));
+                }
+                particles.clear();
+            }
+        }
+    }
+}
+
 void main_object_pool_dynamic_size()
 {
     ObjectPool_DynamicSize_SimpleTest::main_object_pool_01();
     ObjectPool_DynamicSize_SimpleTest::main_object_pool_02();
+    ObjectPool_DynamicSize_SimpleTest::main_object_pool_03();
+    ObjectPool_DynamicSize_SimpleTest::main_object_pool_04();
 
     ObjectPool_DynamicSize_AdvancedTest::main_object_pool_01();
     ObjectPool_DynamicSize_AdvancedTest::main_object_pool_02();
     ObjectPool_DynamicSize_AdvancedTest::main_object_pool_03();
     ObjectPool_DynamicSize_AdvancedTest::main_object_pool_04();
+
+    ObjectPool_DynamicSize_Benchmark::main_object_pool_20();
 }
 
 // ===========================================================================
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdlib>
 #include <new>
 
 namespace FixedSizeObjectPool {
@@ -73,8 +74,8 @@ namespace FixedSizeObjectPool {
     template <typename T, size_t Size>
     inline ObjectPool<T, Size>::~ObjectPool()
     {
-        void* storage = reinterpret_cast<void*>(m_pool);
-        delete[] storage;
+        // storage has been allocated with std::malloc
+        std::free(m_pool);
     }
 
     template <typename T, size_t Size>
@@ -0,0 +1,289 @@
+// ===========================================================================
+// ObjectPool_Persistent.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+namespace PersistentObjectPool {
+
+    // Fixed-size object pool, whose storage lives in a memory-mapped file.
+    // The free list is made of offsets (relative to the start of the mapping)
+    // instead of raw pointers, so the file can be mapped at any address
+    // after a restart. A restart after a clean shutdown just maps the file
+    // and continues - the operating system's page cache loads it lazily.
+
+    template<class T, size_t Size>
+    class ObjectPool final
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "Objects in a persistent pool must be trivially copyable!");
+
+    public:
+        using value_type = T;
+        using offset_type = std::uint64_t;
+
+        static constexpr std::uint32_t Version{ 1 };
+        static constexpr offset_type   NullOffset{ 0 };  // offset 0 is the header - never a block
+
+        // c'tor/d'tor
+        explicit ObjectPool(std::string_view fileName);
+        ~ObjectPool();
+
+        // no copy / no move
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator =(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&& other) noexcept = delete;
+        ObjectPool& operator= (ObjectPool&& other) noexcept = delete;
+
+        [[nodiscard]] T* allocate();
+        void deallocate(T* p) noexcept;
+
+        template<typename ...TArgs>
+        [[nodiscard]] T* construct(TArgs&& ...args);
+        void destroy(T* p) noexcept;
+
+        // offsets remain valid across restarts, raw pointers don't
+        offset_type toOffset(const T* p) const noexcept;
+        T* fromOffset(offset_type offset) noexcept;
+
+        // access to the n.th block (the caller knows which blocks are in use)
+        T* at(size_t index) noexcept;
+
+        // user defined root entry, e.g. the offset of an index structure
+        offset_type root() const noexcept;
+        void setRoot(offset_type offset) noexcept;
+
+        // write all dirty pages back to the file
+        void flush() noexcept;
+
+        size_t size() const noexcept;
+        size_t capacity() const noexcept;
+        bool   isWarmStart() const noexcept;
+
+    private:
+        struct Header
+        {
+            std::uint64_t m_magic;
+            std::uint32_t m_version;
+            std::uint32_t m_cleanShutdown;
+            std::uint64_t m_blockSize;
+            std::uint64_t m_size;
+            std::uint64_t m_used;
+            offset_type   m_nextFree;
+            offset_type   m_root;
+        };
+
+        static constexpr std::uint64_t Magic{ 0x4C4F4F5042534550 };  // "PESBPOOL"
+
+        static constexpr size_t BlockAlign{ std::max(alignof(T), alignof(offset_type)) };
+        static constexpr size_t BlockSize{
+            (std::max(sizeof(T), sizeof(offset_type)) + BlockAlign - 1) / BlockAlign * BlockAlign
+        };
+        static constexpr size_t HeaderSize{
+            (sizeof(Header) + std::hardware_destructive_interference_size - 1) /
+            std::hardware_destructive_interference_size * std::hardware_destructive_interference_size
+        };
+        static constexpr size_t FileSize{ HeaderSize + Size * BlockSize };
+
+        static_assert(BlockAlign <= std::hardware_destructive_interference_size,
+            "Over-aligned types are not supported!");
+
+        static_assert(Size > 0,
+            "A pool needs at least one block!");
+
+        // private helper methods
+        bool isValid() const noexcept;
+        void format() noexcept;
+
+        offset_type& nextOf(offset_type offset) noexcept;
+
+        MemoryMappedFile m_file;
+        Header*          m_header;
+        bool             m_warmStart;
+    };
+
+    template <typename T, size_t Size>
+    inline ObjectPool<T, Size>::ObjectPool(std::string_view fileName)
+        : m_file{ fileName, MemoryMappedFile::Mode::ReadWrite, FileSize },
+          m_header{ reinterpret_cast<Header*>(m_file.data()) },
+          m_warmStart{ false }
+    {
+        // after a crash the free list can't be trusted: rebuild it
+        if (!m_file.isNew() && isValid() && m_header->m_cleanShutdown == 1) {
+            m_warmStart = true;
+        }
+        else {
+            format();
+        }
+
+        // mark the file as 'in use' until the pool is closed properly
+        m_header->m_cleanShutdown = 0;
+    }
+
+    template <typename T, size_t Size>
+    inline ObjectPool<T, Size>::~ObjectPool()
+    {
+        // write the data blocks first, then commit the clean shutdown flag
+        m_file.flush();
+        m_header->m_cleanShutdown = 1;
+        m_file.flush();
+    }
+
+    template <typename T, size_t Size>
+    inline bool ObjectPool<T, Size>::isValid() const noexcept
+    {
+        return
+            m_header->m_magic == Magic &&
+            m_header->m_version == Version &&
+            m_header->m_blockSize == BlockSize &&
+            m_header->m_size == Size;
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::format() noexcept
+    {
+        m_header->m_magic = Magic;
+        m_header->m_version = Version;
+        m_header->m_cleanShutdown = 0;
+        m_header->m_blockSize = BlockSize;
+        m_header->m_size = Size;
+        m_header->m_used = 0;
+        m_header->m_root = NullOffset;
+
+        // setup list of free block offsets (within the mapped file)
+        offset_type offset{ HeaderSize };
+        for (size_t count = Size; count > 1; --count, offset += BlockSize) {
+            nextOf(offset) = offset + BlockSize;
+        }
+
+        nextOf(offset) = NullOffset;
+        m_header->m_nextFree = HeaderSize;
+    }
+
+    template <typename T, size_t Size>
+    inline typename ObjectPool<T, Size>::offset_type& ObjectPool<T, Size>::nextOf(offset_type offset) noexcept
+    {
+        return *reinterpret_cast<offset_type*>(m_file.data() + offset);
+    }
+
+    template <typename T, size_t Size>
+    [[nodiscard]] inline T* ObjectPool<T, Size>::allocate()
+    {
+        if (m_header->m_nextFree == NullOffset) {
+            throw std::bad_alloc{};
+        }
+
+        const auto offset{ m_header->m_nextFree };
+        m_header->m_nextFree = nextOf(offset);
+
+        ++m_header->m_used;
+        return fromOffset(offset);
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::deallocate(T* ptr) noexcept
+    {
+        const auto offset{ toOffset(ptr) };
+
+        nextOf(offset) = m_header->m_nextFree;
+        m_header->m_nextFree = offset;
+
+        --m_header->m_used;
+    }
+
+    template <typename T, size_t Size>
+    template<typename ...TArgs>
+    [[nodiscard]] inline T* ObjectPool<T, Size>::construct(TArgs&& ...args)
+    {
+        T* ptr = allocate();
+        std::construct_at(ptr, std::forward<TArgs>(args)...);
+        return ptr;
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::destroy(T* ptr) noexcept
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+
+        std::destroy_at(ptr);
+        deallocate(ptr);
+    }
+
+    template <typename T, size_t Size>
+    inline typename ObjectPool<T, Size>::offset_type ObjectPool<T, Size>::toOffset(const T* ptr) const noexcept
+    {
+        if (ptr == nullptr) {
+            return NullOffset;
+        }
+
+        return static_cast<offset_type>(reinterpret_cast<const std::byte*>(ptr) - m_file.data());
+    }
+
+    template <typename T, size_t Size>
+    inline T* ObjectPool<T, Size>::fromOffset(offset_type offset) noexcept
+    {
+        if (offset == NullOffset) {
+            return nullptr;
+        }
+
+        return std::launder(reinterpret_cast<T*>(m_file.data() + offset));
+    }
+
+    template <typename T, size_t Size>
+    inline T* ObjectPool<T, Size>::at(size_t index) noexcept
+    {
+        return fromOffset(HeaderSize + index * BlockSize);
+    }
+
+    template <typename T, size_t Size>
+    inline typename ObjectPool<T, Size>::offset_type ObjectPool<T, Size>::root() const noexcept
+    {
+        return m_header->m_root;
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::setRoot(offset_type offset) noexcept
+    {
+        m_header->m_root = offset;
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::flush() noexcept
+    {
+        m_file.flush();
+    }
+
+    template <typename T, size_t Size>
+    inline size_t ObjectPool<T, Size>::size() const noexcept
+    {
+        return Size;
+    }
+
+    template <typename T, size_t Size>
+    inline size_t ObjectPool<T, Size>::capacity() const noexcept
+    {
+        return Size - m_header->m_used;
+    }
+
+    template <typename T, size_t Size>
+    inline bool ObjectPool<T, Size>::isWarmStart() const noexcept
+    {
+        return m_warmStart;
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,150 @@
+// ===========================================================================
+// ObjectPool_Persistent_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "ObjectPool_FixedSize.h"
+#include "ObjectPool_Persistent.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <print>
+#include <string_view>
+
+namespace ObjectPool_Persistent_SimpleTest {
+
+    using namespace PersistentObjectPool;
+
+    static constexpr std::string_view FileName{ "PersistentPool_Simple.bin" };
+
+    static void main_object_pool_persistent_01()
+    {
+        std::remove(FileName.data());
+
+        {
+            ObjectPool<int, 10> pool{ FileName };
+            std::println("Warm start: {}", pool.isWarmStart());
+
+            auto ptr = pool.construct(123);
+            pool.setRoot(pool.toOffset(ptr));
+
+            std::println("*ptr:     {}", *ptr);
+            std::println("capacity: {}", pool.capacity());
+        }
+
+        {
+            // "restart" - the object is still there
+            ObjectPool<int, 10> pool{ FileName };
+            std::println("Warm start: {}", pool.isWarmStart());
+
+            auto ptr = pool.fromOffset(pool.root());
+
+            std::println("*ptr:     {}", *ptr);
+            std::println("capacity: {}", pool.capacity());
+
+            pool.destroy(ptr);
+            pool.setRoot(ObjectPool<int, 10>::NullOffset);
+        }
+
+        std::remove(FileName.data());
+    }
+}
+
+namespace ObjectPool_Persistent_AdvancedTest {
+
+    using namespace PersistentObjectPool;
+
+    struct Record
+    {
+        std::uint64_t m_id;
+        double        m_values[6];
+        char          m_name[16];
+    };
+
+    // some "expensive" computation, which is needed to rebuild a record
+    static Record makeRecord(std::uint64_t id)
+    {
+        Record record{};
+        record.m_id = id;
+        for (int i{}; auto& value : record.m_values) {
+            value = std::sqrt(static_cast<double>(id + i));
+            ++i;
+        }
+        std::snprintf(record.m_name, sizeof(record.m_name), "Record_%llu", static_cast<unsigned long long>(id));
+        return record;
+    }
+
+#ifdef _DEBUG
+    static constexpr size_t NumRecords = 100'000;
+#else
+    static constexpr size_t NumRecords = 1'000'000;
+#endif
+
+    static constexpr std::string_view FileName{ "PersistentPool_Records.bin" };
+
+    static void main_object_pool_persistent_10()
+    {
+        std::remove(FileName.data());
+
+        {
+            std::println("Rebuild: FixedSizeObjectPool::ObjectPool with {} records", NumRecords);
+
+            ScopedTimer timer;
+
+            auto pool{ std::make_unique<FixedSizeObjectPool::ObjectPool<Record, NumRecords>>() };
+            for (size_t i{}; i != NumRecords; ++i) {
+                [[maybe_unused]] auto ptr = pool->construct(makeRecord(i));
+            }
+        }
+
+        {
+            std::println("Cold start: PersistentObjectPool::ObjectPool with {} records (file is created)", NumRecords);
+
+            ScopedTimer timer;
+
+            ObjectPool<Record, NumRecords> pool{ FileName };
+            for (size_t i{}; i != NumRecords; ++i) {
+                [[maybe_unused]] auto ptr = pool.construct(makeRecord(i));
+            }
+        }
+
+        {
+            std::println("Warm start: PersistentObjectPool::ObjectPool with {} records (file is mapped)", NumRecords);
+
+            ScopedTimer timer;
+
+            ObjectPool<Record, NumRecords> pool{ FileName };
+            std::println("Warm start: {}", pool.isWarmStart());
+        }
+
+        {
+            std::println("Warm start: PersistentObjectPool::ObjectPool with {} records (all records touched)", NumRecords);
+
+            ScopedTimer timer;
+
+            ObjectPool<Record, NumRecords> pool{ FileName };
+
+            double sum{};
+            for (size_t i{}; i != NumRecords; ++i) {
+                sum += pool.at(i)->m_values[0];
+            }
+
+            std::println("Warm start: {} - Checksum: {:.3f}", pool.isWarmStart(), sum);
+        }
+
+        std::remove(FileName.data());
+    }
+}
+
+void main_object_pool_persistent()
+{
+    ObjectPool_Persistent_SimpleTest::main_object_pool_persistent_01();
+
+    ObjectPool_Persistent_AdvancedTest::main_object_pool_persistent_10();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
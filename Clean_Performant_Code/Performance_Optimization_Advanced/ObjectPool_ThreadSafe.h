@@ -1,19 +1,54 @@
 // ===========================================================================
 // ObjectPool_ThreadSafe.h // Performance Optimization Advanced
-// Status: Not yet prepared // To be Done
 // ===========================================================================
 
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <new>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
 
 namespace FixedSizeObjectPoolThreadSafe {
 
+    // Lock-free, growable object pool:
+    //
+    //  * Blocks are addressed by a 32-bit index. The head of a free list
+    //    is the index of its first block together with a 32-bit tag,
+    //    packed into one 64-bit atomic. Every update of a head increments
+    //    the tag, so a compare-and-swap with a stale head fails (ABA).
+    //
+    //  * There is one free list (shard) per core. A thread allocates from
+    //    and frees to the shard of the core it is running on; an empty
+    //    shard steals a batch of at most 'StealBatch' blocks from another shard.
+    //
+    //  * If all shards are empty, the pool grows by a new chunk: chunk k
+    //    holds Size * 2^k blocks. Chunks are released by the d'tor only,
+    //    so a block address stays valid for the lifetime of the pool.
+
     template<class T, size_t Size = 3>
     class ObjectPool final
     {
+        static_assert(Size > 0, "Size must be greater than zero!");
+
     public:
         using value_type = T;
 
@@ -34,71 +69,107 @@ namespace FixedSizeObjectPoolThreadSafe {
         [[nodiscard]] T* construct(TArgs&& ...args);
         void destroy(T* p) noexcept;
 
+        // number of blocks in all chunks
+        size_t capacity() const noexcept;
+        size_t shards() const noexcept { return m_numShards; }
+
     private:
-        struct FreeList
+        static constexpr std::uint32_t NullIndex{ 0xFFFF'FFFF };
+        static constexpr size_t        MaxChunks{ 32 };
+        static constexpr size_t        StealBatch{ 32 };
+
+        // the link to the next free block is a field of its own, not part of the storage:
+        // pop() may read the link of a block, which another thread has just taken
+        // and constructs an object in - the storage and the link never overlap.
+        // The index of a block never changes.
+        struct Slot
         {
-            FreeList* m_next;
+            alignas(T) std::byte       m_storage[sizeof(T)];
+            std::uint32_t              m_index;
+            std::atomic<std::uint32_t> m_next;
         };
 
-        FreeList*              m_pool;
-        std::atomic<FreeList*> m_nextFree;
-        size_t                 m_size;
-    };
+        // head of a free list: tag (upper 32 bits) and index (lower 32 bits)
+        struct alignas(std::hardware_destructive_interference_size) Shard
+        {
+            std::atomic<std::uint64_t> m_head{ NullIndex };
+        };
 
-    template <typename T, size_t Size>
-    inline ObjectPool<T, Size>::ObjectPool()
-        : m_pool{ nullptr }, m_nextFree{ nullptr }, m_size{ Size }
-    {
-        size_t blockSize = std::max(sizeof(T), sizeof(void*));
+        static constexpr std::uint64_t makeHead(std::uint64_t head, std::uint32_t index) noexcept {
+            return ((head >> 32) + 1) << 32 | index;
+        }
 
-        auto* storage = std::malloc(m_size * blockSize);
-        if (storage == nullptr) {
-            throw std::bad_alloc{};
+        static constexpr std::uint32_t indexOf(std::uint64_t head) noexcept {
+            return static_cast<std::uint32_t>(head);
         }
 
-        m_pool = reinterpret_cast<FreeList*>(storage);
+        // private helper methods
+        Slot& slot(std::uint32_t index) const noexcept;
+        std::atomic<std::uint32_t>& link(std::uint32_t index) const noexcept;
 
-        // setup list of free blocks pointers (within allocated memory arena)
-        std::byte* ptr = reinterpret_cast<std::byte*>(m_pool);
-        for (size_t count = m_size; count > 1; --count, ptr += blockSize) {
-            *reinterpret_cast<std::byte**>(ptr) = ptr + blockSize;
-        }
+        Shard& homeShard() noexcept;
+
+        std::uint32_t pop(Shard& shard) noexcept;
+        void push(Shard& shard, std::uint32_t first, std::uint32_t last) noexcept;
+        std::uint32_t steal(Shard& home) noexcept;
+        std::uint32_t grow(Shard& home);
+
+        static size_t chunkBlocks(size_t chunk) noexcept { return Size << chunk; }
+        static size_t chunkBegin(size_t chunk) noexcept { return Size * ((size_t{ 1 } << chunk) - 1); }
+
+        // member data
+        std::unique_ptr<Shard[]>                   m_shards;
+        size_t                                     m_numShards;
+        std::array<std::atomic<Slot*>, MaxChunks>  m_chunks;
+    };
+
+    // =======================================================================
+    // c'tor/d'tor
 
-        *reinterpret_cast<std::byte**>(ptr) = nullptr;
-        m_nextFree = &m_pool[0];
+    template <typename T, size_t Size>
+    inline ObjectPool<T, Size>::ObjectPool()
+        : m_numShards{ std::bit_ceil(std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 64)) },
+          m_chunks{}
+    {
+        m_shards = std::make_unique<Shard[]>(m_numShards);
     }
 
     template <typename T, size_t Size>
     inline ObjectPool<T, Size>::~ObjectPool()
     {
-        void* storage = reinterpret_cast<void*>(m_pool);
-        delete[] storage;
+        for (auto& chunk : m_chunks) {
+            if (Slot* slots{ chunk.load(std::memory_order_relaxed) }; slots != nullptr) {
+                ::operator delete(slots, std::align_val_t{ alignof(Slot) });
+            }
+        }
     }
 
+    // =======================================================================
+    // public interface
+
     template <typename T, size_t Size>
     [[nodiscard]] inline T* ObjectPool<T, Size>::allocate()
     {
-        auto item = m_nextFree.load();
-        while (item != nullptr && !m_nextFree.compare_exchange_weak(item, item->m_next))
-        {
+        Shard& home{ homeShard() };
+
+        std::uint32_t index{ pop(home) };
+
+        if (index == NullIndex) {
+            index = steal(home);
         }
 
-        if (item == nullptr) {
-            throw std::bad_alloc{};
+        if (index == NullIndex) {
+            index = grow(home);
         }
-        
-        return reinterpret_cast<T*>(item);
+
+        return reinterpret_cast<T*>(slot(index).m_storage);
     }
 
     template <typename T, size_t Size>
     inline void ObjectPool<T, Size>::deallocate(T* ptr) noexcept
     {
-        const auto item = reinterpret_cast<FreeList*>(ptr);
-
-        item->m_next = m_nextFree;
-        while (!m_nextFree.compare_exchange_weak(item->m_next, item))
-        {
-        }
+        const std::uint32_t index{ reinterpret_cast<Slot*>(ptr)->m_index };
+        push(homeShard(), index, index);
     }
 
     template <typename T, size_t Size>
@@ -106,7 +177,15 @@ namespace FixedSizeObjectPoolThreadSafe {
     [[nodiscard]] inline T* ObjectPool<T, Size>::construct(TArgs&& ...args)
     {
         T* ptr = allocate();
-        std::construct_at(ptr, std::forward<TArgs>(args)...);
+
+        try {
+            std::construct_at(ptr, std::forward<TArgs>(args)...);
+        }
+        catch (...) {
+            deallocate(ptr);
+            throw;
+        }
+
         return ptr;
     }
 
@@ -120,6 +199,177 @@ namespace FixedSizeObjectPoolThreadSafe {
         std::destroy_at(ptr);
         deallocate(ptr);
     }
+
+    template <typename T, size_t Size>
+    inline size_t ObjectPool<T, Size>::capacity() const noexcept
+    {
+        size_t blocks{};
+        for (size_t chunk{}; chunk != MaxChunks; ++chunk) {
+            if (m_chunks[chunk].load(std::memory_order_relaxed) != nullptr) {
+                blocks += chunkBlocks(chunk);
+            }
+        }
+        return blocks;
+    }
+
+    // =======================================================================
+    // private helper methods
+
+    template <typename T, size_t Size>
+    inline typename ObjectPool<T, Size>::Slot& ObjectPool<T, Size>::slot(std::uint32_t index) const noexcept
+    {
+        // chunk k covers the indices [Size * (2^k - 1), Size * (2^(k+1) - 1))
+        const size_t chunk{ static_cast<size_t>(std::bit_width(index / Size + 1)) - 1 };
+        Slot* slots{ m_chunks[chunk].load(std::memory_order_acquire) };
+        return slots[index - chunkBegin(chunk)];
+    }
+
+    template <typename T, size_t Size>
+    inline std::atomic<std::uint32_t>& ObjectPool<T, Size>::link(std::uint32_t index) const noexcept
+    {
+        // a thread may read the link of a block, which has just been handed out
+        // to another thread - the value is stale then, but the tag check fails
+        return slot(index).m_next;
+    }
+
+    template <typename T, size_t Size>
+    inline typename ObjectPool<T, Size>::Shard& ObjectPool<T, Size>::homeShard() noexcept
+    {
+#if defined(_WIN32)
+        const size_t cpu{ ::GetCurrentProcessorNumber() };
+#elif defined(__linux__)
+        const int current{ ::sched_getcpu() };
+        const size_t cpu{ current >= 0 ? static_cast<size_t>(current) : 0 };
+#else
+        // no cheap way to ask for the current core: spread the threads round robin
+        static std::atomic<size_t> s_nextShard{};
+        thread_local const size_t cpu{ s_nextShard.fetch_add(1, std::memory_order_relaxed) };
+#endif
+        return m_shards[cpu & (m_numShards - 1)];
+    }
+
+    template <typename T, size_t Size>
+    inline std::uint32_t ObjectPool<T, Size>::pop(Shard& shard) noexcept
+    {
+        std::uint64_t head{ shard.m_head.load(std::memory_order_acquire) };
+
+        while (indexOf(head) != NullIndex) {
+
+            const std::uint32_t next{ link(indexOf(head)).load(std::memory_order_relaxed) };
+
+            if (shard.m_head.compare_exchange_weak(head, makeHead(head, next),
+                std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return indexOf(head);
+            }
+        }
+
+        return NullIndex;
+    }
+
+    template <typename T, size_t Size>
+    inline void ObjectPool<T, Size>::push(Shard& shard, std::uint32_t first, std::uint32_t last) noexcept
+    {
+        // push the chain [first, ..., last] in front of the list
+        std::uint64_t head{ shard.m_head.load(std::memory_order_relaxed) };
+
+        do {
+            link(last).store(indexOf(head), std::memory_order_relaxed);
+        } while (!shard.m_head.compare_exchange_weak(head, makeHead(head, first),
+            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template <typename T, size_t Size>
+    inline std::uint32_t ObjectPool<T, Size>::steal(Shard& home) noexcept
+    {
+        const size_t start{ static_cast<size_t>(&home - m_shards.get()) };
+
+        for (size_t i{ 1 }; i != m_numShards; ++i) {
+
+            Shard& victim{ m_shards[(start + i) & (m_numShards - 1)] };
+
+            // a bounded batch, not the complete list: if threads on different cores
+            // alternate, a complete list would bounce between the shards - and
+            // finding its tail would cost O(free blocks) per allocation
+            const std::uint32_t first{ pop(victim) };
+            if (first == NullIndex) {
+                continue;
+            }
+
+            // keep the first block, chain the others and move them to the home shard at once
+            std::uint32_t batchFirst{ NullIndex };
+            std::uint32_t batchLast{ NullIndex };
+
+            for (size_t n{ 1 }; n != StealBatch; ++n) {
+
+                const std::uint32_t index{ pop(victim) };
+                if (index == NullIndex) {
+                    break;
+                }
+
+                link(index).store(batchFirst, std::memory_order_relaxed);
+                if (batchLast == NullIndex) {
+                    batchLast = index;
+                }
+                batchFirst = index;
+            }
+
+            if (batchFirst != NullIndex) {
+                push(home, batchFirst, batchLast);
+            }
+
+            return first;
+        }
+
+        return NullIndex;
+    }
+
+    template <typename T, size_t Size>
+    inline std::uint32_t ObjectPool<T, Size>::grow(Shard& home)
+    {
+        for (size_t chunk{}; chunk != MaxChunks; ++chunk) {
+
+            if (m_chunks[chunk].load(std::memory_order_acquire) != nullptr) {
+                continue;
+            }
+
+            const size_t blocks{ chunkBlocks(chunk) };
+            if (chunkBegin(chunk) + blocks >= NullIndex) {
+                break;
+            }
+
+            Slot* slots{ static_cast<Slot*>(::operator new(blocks * sizeof(Slot), std::align_val_t{ alignof(Slot) })) };
+
+            const auto first{ static_cast<std::uint32_t>(chunkBegin(chunk)) };
+            for (size_t i{}; i != blocks; ++i) {
+                std::construct_at(&slots[i].m_index, static_cast<std::uint32_t>(first + i));
+                std::construct_at(&slots[i].m_next, static_cast<std::uint32_t>(first + i + 1));
+            }
+
+            // publish the chunk - another thread might have been faster
+            Slot* expected{ nullptr };
+            if (!m_chunks[chunk].compare_exchange_strong(expected, slots, std::memory_order_acq_rel)) {
+                ::operator delete(slots, std::align_val_t{ alignof(Slot) });
+                --chunk;   // look at the same chunk again: the winner's blocks may already be available
+                if (std::uint32_t index{ pop(home) }; index != NullIndex) {
+                    return index;
+                }
+                if (std::uint32_t index{ steal(home) }; index != NullIndex) {
+                    return index;
+                }
+                continue;
+            }
+
+            // keep the first block, all other blocks go to the home shard
+            if (blocks > 1) {
+                push(home, first + 1, static_cast<std::uint32_t>(first + blocks - 1));
+            }
+
+            return first;
+        }
+
+        throw std::bad_alloc{};
+    }
 }
 
 // ===========================================================================
@@ -1,12 +1,15 @@
 // ===========================================================================
 // ObjectPool_ThreadSafe_02.h // Performance Optimization Advanced
 // From: https://radiantsoftware.hashnode.dev/c-lock-free-object-pool
-// Status: Not yet prepared // To be Done
 // ===========================================================================
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
 #include <new>
 #include <utility>
 
@@ -28,6 +31,14 @@ private:
 static_assert(std::atomic<GuardedIndex>::is_always_lock_free,
     "This will be much slower! Consider reducing the size of the members!");
 
+// Lock-free pool of 'DataType' objects, addressed by their slot index.
+// The free slots form a singly linked list of indices (mFreeList),
+// its head is an index together with a guard counter: each update of
+// the head increments the counter, so a compare-and-swap with a stale
+// head fails even if the same index has become the head again (ABA).
+// With 'Awaitable' set, emplaceAwait() blocks (std::atomic::wait)
+// while the pool is full, instead of returning a failure.
+
 template <typename DataType, bool Awaitable = false>
 class Pool
 {
@@ -35,9 +46,16 @@ private:
     //Get the cache line size (typically 64 bytes)
     static constexpr auto sMemberAlign = std::hardware_destructive_interference_size;
 
+    //Storage is allocated in units of whole, cache line aligned blocks
+    static constexpr auto sDataAlign = std::max(alignof(DataType), sMemberAlign);
+    static constexpr auto sListAlign = std::max(alignof(int), sMemberAlign);
+
+    struct alignas(sDataAlign) DataBlock { std::byte mBytes[sDataAlign]; };
+    struct alignas(sListAlign) ListBlock { std::byte mBytes[sListAlign]; };
+
     //Modified frequently during operations:
     alignas(sMemberAlign) std::atomic<int> mSize = 0;
-    alignas(sMemberAlign) GuardedIndex mHeadNodeIndex;
+    alignas(sMemberAlign) GuardedIndex mHeadNodeIndex{ -1 };
 
     //Not modified post-allocation:
     alignas(sMemberAlign) std::byte* mStorage = nullptr; //Object memory
@@ -45,17 +63,30 @@ private:
     int mCapacity = 0;
 
 public:
+    // c'tor/d'tor
+    Pool() = default;
+    ~Pool();
+
+    // no copy / no move
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    Pool(Pool&&) noexcept = delete;
+    Pool& operator=(Pool&&) noexcept = delete;
+
+    // memory management - neither of them is thread-safe
     template <typename AllocatorType>
     void allocate(AllocatorType& aAllocator, int aCapacity);
 
     template <typename AllocatorType>
     void free(AllocatorType& aAllocator);
 
+    // returns { false, -1 }, if the pool is full
     template <typename... ArgumentTypes>
     std::pair<bool, int> emplace(ArgumentTypes&&... aArguments);
 
+    // blocks, until a slot is available
     template <typename... ArgumentTypes>
-    //  requires (Awaitable)
+        requires (Awaitable)
     int emplaceAwait(ArgumentTypes&&... aArguments);
 
     DataType& operator[](int aIndex);
@@ -63,94 +94,101 @@ public:
 
     void erase(int aIndex);
 
-    void decreaseSize();
-
     int size() const;
+    int capacity() const;
     bool empty() const;
+
+private:
+    void pushFreeSlot(int aIndex);
+    void decreaseSize();
+
+    static std::size_t numDataBlocks(int aCapacity);
+    static std::size_t numListBlocks(int aCapacity);
 };
 
+template <typename DataType, bool Awaitable>
+inline Pool<DataType, Awaitable>::~Pool()
+{
+    //free() has to be called with the allocator, that was passed to allocate()
+    assert(mStorage == nullptr && "Pool memory not freed!");
+}
 
-template <typename DataType, bool Awaitable >
+template <typename DataType, bool Awaitable>
 template <typename AllocatorType>
 inline void Pool<DataType, Awaitable>::allocate(AllocatorType& aAllocator, int aCapacity)
 {
-    DataType* ptr = nullptr;
+    assert(mStorage == nullptr && aCapacity > 0);
 
-    //Allocate the object memory
-    // Original
-    // static constexpr auto sDataAlign = std::max(alignof(DataType), sMemberAlign);
+    //Rebind the allocator to cache line sized blocks: these types are over-aligned,
+    //so std::allocator uses the aligned forms of operator new
+    using DataAllocator = typename std::allocator_traits<AllocatorType>::template rebind_alloc<DataBlock>;
+    using ListAllocator = typename std::allocator_traits<AllocatorType>::template rebind_alloc<ListBlock>;
 
+    DataAllocator cDataAllocator(aAllocator);
+    ListAllocator cListAllocator(aAllocator);
 
-    static auto sDataAlign = std::max(alignof(DataType), sMemberAlign);
-
-
-
-    // Original
-    // mStorage = aAllocator.allocate(aCapacity * sizeof(DataType), sDataAlign);
-
-    // adpopted
-    auto size = aCapacity * sizeof(DataType);
-    // auto* memory = aAllocator.allocate(aCapacity * sizeof(DataType));  // Da ist das Alignmenet Thema offen // original
-    // 
-    
-    
-    
-    // WEITER: Ist nicht bersetzungsfhig
-    //auto* memory = aAllocator.allocate(size);
-    //mStorage = static_cast<DataType>(memory);
-
-
-
-
-    mCapacity = aCapacity;
-
-    // allocate the free list memory
-    static constexpr auto sListAlign = std::max(alignof(int), sMemberAlign);
+    //Allocate the object memory
+    DataBlock* cStorageMemory = cDataAllocator.allocate(numDataBlocks(aCapacity));
 
-    // Original
-    //auto cFreeListMemory = aAllocator.allocate(aCapacity * sizeof(int), sListAlign);
-    //mFreeList = reinterpret_cast<int*>(cFreeListMemory);
+    //Allocate the free list memory
+    ListBlock* cFreeListMemory = nullptr;
+    try {
+        cFreeListMemory = cListAllocator.allocate(numListBlocks(aCapacity));
+    }
+    catch (...) {
+        cDataAllocator.deallocate(cStorageMemory, numDataBlocks(aCapacity));
+        throw;
+    }
 
-    auto cFreeListMemory = aAllocator.allocate(aCapacity * sizeof(int));
+    mStorage = reinterpret_cast<std::byte*>(cStorageMemory);
     mFreeList = reinterpret_cast<int*>(cFreeListMemory);
+    mCapacity = aCapacity;
 
-
-
-    //Initialize free list  // ????????????????????
-    //for (int ci = 0; ci < (aCapacity - 1); ++ci)
-    //    new (&mFreeList[ci]) = int(ci + 1);
-    //new (&mFreeList[aCapacity - 1]) = int(-1);
-
+    //Initialize free list: each slot links to its successor
     for (int ci = 0; ci < (aCapacity - 1); ++ci)
         new (&mFreeList[ci]) int(ci + 1);
-    new (&mFreeList[aCapacity - 1])  int(-1);
+    new (&mFreeList[aCapacity - 1]) int(-1);
 
-    //Publish free list head node. 
-    mHeadNodeIndex.Set_Index(0);
+    //Publish free list head node
+    mSize.store(0, std::memory_order::relaxed);
+    std::atomic_ref(mHeadNodeIndex).store(GuardedIndex{ 0 }, std::memory_order::release);
 }
 
-template <typename DataType, bool Awaitable >
+template <typename DataType, bool Awaitable>
 template <typename AllocatorType>
 inline void Pool<DataType, Awaitable>::free(AllocatorType& aAllocator)
 {
-    Assert(empty(), "Objects not destroyed!\n");
+    assert(empty() && "Objects not destroyed!");
+
+    using DataAllocator = typename std::allocator_traits<AllocatorType>::template rebind_alloc<DataBlock>;
+    using ListAllocator = typename std::allocator_traits<AllocatorType>::template rebind_alloc<ListBlock>;
+
+    DataAllocator cDataAllocator(aAllocator);
+    ListAllocator cListAllocator(aAllocator);
 
     //Note: no destruction of indices are needed: is trivial type
-    aAllocator.Free(reinterpret_cast<std::byte*>(mFreeList));
+    cListAllocator.deallocate(reinterpret_cast<ListBlock*>(mFreeList), numListBlocks(mCapacity));
     mFreeList = nullptr;
-    aAllocator.Free(mStorage);
+    cDataAllocator.deallocate(reinterpret_cast<DataBlock*>(mStorage), numDataBlocks(mCapacity));
     mStorage = nullptr;
 
     mCapacity = 0;
+    std::atomic_ref(mHeadNodeIndex).store(GuardedIndex{ -1 }, std::memory_order::relaxed);
 }
 
-template <typename DataType, bool Awaitable >
+template <typename DataType, bool Awaitable>
 inline int Pool<DataType, Awaitable>::size() const
 {
     return mSize.load(std::memory_order::relaxed);
 }
 
-template <typename DataType, bool Awaitable >
+template <typename DataType, bool Awaitable>
+inline int Pool<DataType, Awaitable>::capacity() const
+{
+    return mCapacity;
+}
+
+template <typename DataType, bool Awaitable>
 inline bool Pool<DataType, Awaitable>::empty() const
 {
     return (size() == 0);
@@ -164,8 +202,6 @@ inline std::pair<bool, int> Pool<DataType, Awaitable>::emplace(ArgumentTypes&&..
     auto cHead = std::atomic_ref(mHeadNodeIndex);
     GuardedIndex cHeadEntry = cHead.load(std::memory_order::acquire);
 
-    int cFirstSlot{}; // Added PeLo // WELCHER WERT ???????????????????????????
-
     //Loop until we reserve the head node for our object
     int cHeadIndex;
     GuardedIndex cNextSlotEntry;
@@ -174,10 +210,12 @@ inline std::pair<bool, int> Pool<DataType, Awaitable>::emplace(ArgumentTypes&&..
         //Bail if we're full
         cHeadIndex = cHeadEntry.Get_Index();
         if (cHeadIndex == -1)
-            return { false, cFirstSlot };
+            return { false, -1 };
 
-        //Find the next slot in the free list
-        auto cListNode = std::atomic_ref(mFreeList[cFirstSlot]);
+        //Find the next slot in the free list: the value may be stale,
+        //if another thread took this slot meanwhile - then the guard
+        //counter has changed and the compare-and-swap below fails
+        auto cListNode = std::atomic_ref(mFreeList[cHeadIndex]);
         auto cNextSlotIndex = cListNode.load(std::memory_order::relaxed);
 
         //Set next index and guard against ABA
@@ -189,8 +227,15 @@ inline std::pair<bool, int> Pool<DataType, Awaitable>::emplace(ArgumentTypes&&..
         std::memory_order::acquire, std::memory_order::acquire));
 
     //We have exclusive access to this slot. Create new object
-    std::byte* cAddress = mStorage + cFirstSlot * sizeof(DataType);
-    new (cAddress) DataType(std::forward<ArgumentTypes>(aArguments)...);
+    std::byte* cAddress = mStorage + cHeadIndex * sizeof(DataType);
+    try {
+        new (cAddress) DataType(std::forward<ArgumentTypes>(aArguments)...);
+    }
+    catch (...) {
+        //Return the slot, the size has not been increased yet
+        pushFreeSlot(cHeadIndex);
+        throw;
+    }
 
     //Update the size and return
     mSize.fetch_add(1, std::memory_order::relaxed);
@@ -218,6 +263,15 @@ inline void Pool<DataType, Awaitable>::erase(int aIndex)
     //Destroy the object
     (*this)[aIndex].~DataType();
 
+    pushFreeSlot(aIndex);
+
+    //Decrease the size
+    decreaseSize();
+}
+
+template <typename DataType, bool Awaitable>
+inline void Pool<DataType, Awaitable>::pushFreeSlot(int aIndex)
+{
     //Add this index to the front of the list
     auto cHead = std::atomic_ref(mHeadNodeIndex);
     GuardedIndex cHeadEntry = cHead.load(std::memory_order::relaxed);
@@ -235,20 +289,17 @@ inline void Pool<DataType, Awaitable>::erase(int aIndex)
         //Set new value
     } while (!cHead.compare_exchange_weak(cHeadEntry, cNewHeadEntry,
         std::memory_order::release, std::memory_order::relaxed));
-
-    //Decrease the size
-    decreaseSize();
 }
 
 template <typename DataType, bool Awaitable>
 template <typename... ArgumentTypes>
+    requires (Awaitable)
 inline int Pool<DataType, Awaitable>::emplaceAwait(ArgumentTypes&&... aArguments)
-  //requires (Awaitable)
 {
     while (true)
     {
-        auto [cCreated, cIndex] =
-            Emplace(std::forward<ArgumentTypes>(aArguments)...);
+        //Note: the arguments are forwarded only once, when a slot has been reserved
+        auto [cCreated, cIndex] = emplace(std::forward<ArgumentTypes>(aArguments)...);
 
         if (cCreated)
             return cIndex;
@@ -272,6 +323,18 @@ inline void Pool<DataType, Awaitable>::decreaseSize()
     }
 }
 
+template <typename DataType, bool Awaitable>
+inline std::size_t Pool<DataType, Awaitable>::numDataBlocks(int aCapacity)
+{
+    return (aCapacity * sizeof(DataType) + sizeof(DataBlock) - 1) / sizeof(DataBlock);
+}
+
+template <typename DataType, bool Awaitable>
+inline std::size_t Pool<DataType, Awaitable>::numListBlocks(int aCapacity)
+{
+    return (aCapacity * sizeof(int) + sizeof(ListBlock) - 1) / sizeof(ListBlock);
+}
+
 // ===========================================================================
 // End-of-File
 // ===========================================================================
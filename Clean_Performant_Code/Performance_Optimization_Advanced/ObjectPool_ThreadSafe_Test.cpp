@@ -6,9 +6,19 @@
 //#include "../Person/Person.h"
 
 #include "ObjectPool_ThreadSafe.h"
+#include "ObjectPool_ThreadSafe_02.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <print>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 namespace ObjectPool_ThreadSafe_SimpleTest {
 
@@ -25,13 +35,286 @@ namespace ObjectPool_ThreadSafe_SimpleTest {
         pool.destroy(ptr);
         std::println("Done.");
     }
+
+    static void main_object_pool_thread_safe_02()
+    {
+        using namespace FixedSizeObjectPoolThreadSafe;
+
+        // the pool grows in chunks of 3, 6, 12, 24, ... blocks
+        ObjectPool<int> pool;
+
+        std::vector<int*> pointers;
+        for (int i{}; i != 20; ++i) {
+            pointers.push_back(pool.construct(i));
+            std::println("construct({:2}) => capacity: {}", i, pool.capacity());
+        }
+
+        for (auto ptr : pointers) {
+            pool.destroy(ptr);
+        }
+
+        std::println("Shards: {}", pool.shards());
+    }
+}
+
+namespace ObjectPool_ThreadSafe_StressTest {
+
+    using namespace FixedSizeObjectPoolThreadSafe;
+
+    static constexpr int NumThreads = 8;
+    static constexpr int Held = 16;
+
+#ifdef _DEBUG
+    static constexpr int Iterations = 20'000;      // debug
+#else
+    static constexpr int Iterations = 500'000;     // release
+#endif
+
+    struct Payload
+    {
+        std::uint64_t    m_owner;
+        std::uint64_t    m_sequence;
+    };
+
+    // The blocks currently handed out - kept outside of the blocks, so that
+    // neither construct() nor the free list of the pool can reset the information:
+    // a block is registered after construct() and unregistered before destroy().
+    class HandedOut
+    {
+    public:
+        // false, if 'block' is handed out already
+        bool acquire(const void* block) {
+            Shard& shard{ shardOf(block) };
+            std::lock_guard<std::mutex> guard{ shard.m_mutex };
+            return shard.m_blocks.insert(block).second;
+        }
+
+        // false, if 'block' isn't handed out
+        bool release(const void* block) {
+            Shard& shard{ shardOf(block) };
+            std::lock_guard<std::mutex> guard{ shard.m_mutex };
+            return shard.m_blocks.erase(block) == 1;
+        }
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::mutex                       m_mutex;
+            std::unordered_set<const void*>  m_blocks;
+        };
+
+        Shard& shardOf(const void* block) {
+            return m_shards[(reinterpret_cast<std::uintptr_t>(block) / sizeof(Payload)) % m_shards.size()];
+        }
+
+        std::array<Shard, 64> m_shards;
+    };
+
+    // Each thread allocates objects and hands half of them to its neighbour,
+    // so blocks are freed on other threads (and shards) than they were allocated.
+    // A block must never be handed out twice, an object must never be modified by others.
+    static void main_object_pool_thread_safe_10()
+    {
+        std::println("Stress test: {} threads, {} iterations per thread", NumThreads, Iterations);
+
+        ObjectPool<Payload, 8> pool;
+
+        std::array<std::atomic<Payload*>, NumThreads> mailboxes{};
+        std::atomic<int> errors{};
+        HandedOut handedOut{};
+
+        auto release = [&] (Payload* payload, std::uint64_t owner, std::uint64_t sequence) {
+            if (payload->m_owner != owner || payload->m_sequence != sequence || !handedOut.release(payload)) {
+                ++errors;
+            }
+            pool.destroy(payload);
+        };
+
+        auto handOver = [&] (Payload* payload) {
+            if (!handedOut.release(payload)) {
+                ++errors;
+            }
+            pool.destroy(payload);
+        };
+
+        auto worker = [&] (int id) {
+
+            std::array<Payload*, Held> held{};
+
+            for (int i{}; i != Iterations; ++i) {
+
+                auto& current{ held[i % Held] };
+
+                if (current != nullptr) {
+                    release(current, id, i - Held);
+                }
+
+                current = pool.construct(id, i);
+                if (!handedOut.acquire(current)) {
+                    ++errors;
+                }
+
+                // every second object is passed on - and released by the neighbour
+                if (i % 2 == 0) {
+                    Payload* previous{ mailboxes[(id + 1) % NumThreads].exchange(current) };
+                    current = nullptr;
+                    if (previous != nullptr) {
+                        // the neighbour has not picked up the last one yet
+                        handOver(previous);
+                    }
+                }
+
+                if (Payload* received{ mailboxes[id].exchange(nullptr) }; received != nullptr) {
+                    handOver(received);
+                }
+            }
+
+            for (int i{}; i != Held; ++i) {
+                if (held[i] != nullptr) {
+                    release(held[i], id, held[i]->m_sequence);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i{}; i != NumThreads; ++i) {
+            threads.emplace_back(worker, i);
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto& mailbox : mailboxes) {
+            if (Payload* payload{ mailbox.load() }; payload != nullptr) {
+                handOver(payload);
+            }
+        }
+
+        std::println("Errors: {} - Capacity after test: {}", errors.load(), pool.capacity());
+    }
+}
+
+namespace ObjectPool_ThreadSafe_Benchmark {
+
+    struct Particle
+    {
+        double m_x, m_y, m_z;
+        double m_mass;
+    };
+
+    static constexpr int MaxThreads = 64;
+    static constexpr int Batch = 16;
+
+#ifdef _DEBUG
+    static constexpr std::size_t TotalRounds = 200'000;       // debug
+#else
+    static constexpr std::size_t TotalRounds = 1'000'000;     // release
+#endif
+
+    // 'TotalRounds' rounds are split between the threads: each round
+    // acquires 'Batch' objects and releases them again
+    template <typename TRound>
+    static double runThreads(int numThreads, TRound round)
+    {
+        const std::size_t rounds{ TotalRounds / numThreads };
+
+        std::vector<std::thread> threads;
+
+        const auto begin{ std::chrono::steady_clock::now() };
+
+        for (int i{}; i != numThreads; ++i) {
+            threads.emplace_back([&] () {
+                for (std::size_t r{}; r != rounds; ++r) {
+                    round();
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const auto end{ std::chrono::steady_clock::now() };
+        const std::chrono::duration<double> seconds{ end - begin };
+
+        return 2.0 * numThreads * rounds * Batch / seconds.count();
+    }
+
+    static double benchmarkShardedPool(int numThreads)
+    {
+        FixedSizeObjectPoolThreadSafe::ObjectPool<Particle, 64> pool;
+
+        return runThreads(numThreads, [&] () {
+            std::array<Particle*, Batch> pointers;
+            for (auto& ptr : pointers) {
+                ptr = pool.construct(1.0, 2.0, 3.0, 4.0);
+            }
+            for (auto ptr : pointers) {
+                pool.destroy(ptr);
+            }
+        });
+    }
+
+    static double benchmarkIndexPool(int numThreads)
+    {
+        Pool<Particle> pool;
+
+        std::allocator<Particle> alloc;
+        pool.allocate(alloc, MaxThreads * Batch);
+
+        double opsPerSec = runThreads(numThreads, [&] () {
+            std::array<int, Batch> indices;
+            for (auto& index : indices) {
+                index = pool.emplace(1.0, 2.0, 3.0, 4.0).second;
+            }
+            for (auto index : indices) {
+                pool.erase(index);
+            }
+        });
+
+        pool.free(alloc);
+        return opsPerSec;
+    }
+
+    static double benchmarkNewDelete(int numThreads)
+    {
+        return runThreads(numThreads, [] () {
+            std::array<Particle*, Batch> pointers;
+            for (auto& ptr : pointers) {
+                ptr = new Particle{ 1.0, 2.0, 3.0, 4.0 };
+            }
+            for (auto ptr : pointers) {
+                delete ptr;
+            }
+        });
+    }
+
+    static void main_object_pool_thread_safe_20()
+    {
+        std::println("Throughput [million ops/sec] - batches of {} objects, {} cores", Batch, std::thread::hardware_concurrency());
+        std::println("{:>8}{:>22}{:>22}{:>22}", "Threads", "Sharded ObjectPool", "Pool (GuardedIndex)", "new / delete");
+
+        for (int numThreads{ 1 }; numThreads <= MaxThreads; numThreads *= 2) {
+
+            double sharded{ benchmarkShardedPool(numThreads) };
+            double indexed{ benchmarkIndexPool(numThreads) };
+            double newDelete{ benchmarkNewDelete(numThreads) };
+
+            std::println("{:>8}{:>22.2f}{:>22.2f}{:>22.2f}", numThreads,
+                sharded / 1'000'000.0, indexed / 1'000'000.0, newDelete / 1'000'000.0);
+        }
+    }
 }
 
 void main_object_pool_thread_safe()
 {
-    using namespace ObjectPool_ThreadSafe_SimpleTest;
+    ObjectPool_ThreadSafe_SimpleTest::main_object_pool_thread_safe_01();
+    ObjectPool_ThreadSafe_SimpleTest::main_object_pool_thread_safe_02();
+
+    ObjectPool_ThreadSafe_StressTest::main_object_pool_thread_safe_10();
 
-    main_object_pool_thread_safe_01();
+    ObjectPool_ThreadSafe_Benchmark::main_object_pool_thread_safe_20();
 }
 
 // ===========================================================================
@@ -1,16 +1,24 @@
 // ===========================================================================
 // ObjectPool_ThreadSafe_Test_02.cpp // Performance Optimization Advanced
 // From: https://radiantsoftware.hashnode.dev/c-lock-free-object-pool
-// Status: Not yet prepared // To be Done
 // ===========================================================================
 
-// #include "../LoggerUtility/ScopedTimer.h"
 #include "../Person/Person.h"
 
+#include "ObjectPool_ThreadSafe.h"
 #include "ObjectPool_ThreadSafe_02.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <print>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace ObjectPool_ThreadSafe_SimpleTest {
 
@@ -25,23 +33,262 @@ namespace ObjectPool_ThreadSafe_SimpleTest {
 
         pool.allocate(alloc, 20);
 
-        //template <typename AllocatorType>
-        //void allocate(AllocatorType & aAllocator, int aCapacity);
+        auto [created, index] = pool.emplace("Sepp", "Mueller", static_cast<size_t>(30));
 
-        //auto person{ pool.allocate("Sepp", "Mueller", (size_t)30) };
+        if (created) {
+            const Person& person{ pool[index] };
 
-        //std::println("{} {} has age {}",
-        //    person->getFirstname(), person->getLastname(), person->getAge());
+            std::println("{} {} has age {} (slot {})",
+                person.getFirstname(), person.getLastname(), person.getAge(), index);
+
+            pool.erase(index);
+        }
+
+        std::println("Size: {} - Capacity: {}", pool.size(), pool.capacity());
+
+        pool.free(alloc);
 
         std::println("Done.");
     }
+
+    static void main_object_pool_thread_safe_02()
+    {
+        Pool<int> pool;
+
+        std::allocator<int> alloc;
+        pool.allocate(alloc, 3);
+
+        // fill the pool completely
+        std::vector<int> indices;
+        for (int i{}; i != 4; ++i) {
+            auto [created, index] = pool.emplace(10 * i);
+            std::println("emplace({:2}) => created: {} - index: {}", 10 * i, created, index);
+            if (created) {
+                indices.push_back(index);
+            }
+        }
+
+        // free slots are reused in LIFO order
+        pool.erase(indices[1]);
+        auto [created, index] = pool.emplace(99);
+        std::println("emplace(99) => created: {} - index: {}", created, index);
+        indices[1] = index;
+
+        for (auto i : indices) {
+            std::println("pool[{}] = {}", i, pool[i]);
+            pool.erase(i);
+        }
+
+        pool.free(alloc);
+    }
+}
+
+namespace ObjectPool_ThreadSafe_StressTest {
+
+    // each thread holds up to 'Held' objects, the pool cannot satisfy all threads at once:
+    // emplaceAwait has to block - but at least one thread can always make progress
+    static constexpr int NumThreads = 8;
+    static constexpr int Held = 3;
+    static constexpr int Capacity = NumThreads * Held + 1;
+
+#ifdef _DEBUG
+    static constexpr int Iterations = 20'000;      // debug
+#else
+    static constexpr int Iterations = 200'000;     // release
+#endif
+
+    struct Payload
+    {
+        std::uint64_t m_owner;
+        std::uint64_t m_sequence;
+        std::uint64_t m_check;
+
+        Payload(std::uint64_t owner, std::uint64_t sequence)
+            : m_owner{ owner }, m_sequence{ sequence }, m_check{ checksum(owner, sequence) }
+        {}
+
+        static std::uint64_t checksum(std::uint64_t owner, std::uint64_t sequence) {
+            return (owner * 0x9E3779B97F4A7C15ull) ^ sequence;
+        }
+    };
+
+    static void main_object_pool_thread_safe_10()
+    {
+        std::println("Stress test: {} threads, capacity {}, {} iterations per thread", NumThreads, Capacity, Iterations);
+
+        Pool<Payload, true> pool;
+
+        std::allocator<Payload> alloc;
+        pool.allocate(alloc, Capacity);
+
+        // a slot must never be handed out twice
+        std::array<std::atomic<int>, Capacity> inUse{};
+        std::atomic<int> errors{};
+
+        auto worker = [&] (std::uint64_t owner) {
+
+            std::array<std::pair<int, std::uint64_t>, Held> held{};
+            int count{};
+
+            for (std::uint64_t sequence{}; sequence != Iterations; ++sequence) {
+
+                if (count == Held) {
+                    // release the oldest object - after checking, that nobody touched it
+                    auto [index, expected] = held[sequence % Held];
+                    const Payload& payload{ pool[index] };
+
+                    if (payload.m_owner != owner || payload.m_sequence != expected ||
+                        payload.m_check != Payload::checksum(owner, expected))
+                    {
+                        ++errors;
+                    }
+
+                    inUse[index].store(0);
+                    pool.erase(index);
+                    --count;
+                }
+
+                int index{ pool.emplaceAwait(owner, sequence) };
+
+                if (inUse[index].exchange(1) != 0) {
+                    ++errors;
+                }
+
+                held[sequence % Held] = { index, sequence };
+                ++count;
+            }
+
+            for (auto [index, sequence] : held) {
+                inUse[index].store(0);
+                pool.erase(index);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i{}; i != NumThreads; ++i) {
+            threads.emplace_back(worker, static_cast<std::uint64_t>(i + 1));
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::println("Errors: {} - Size after test: {}", errors.load(), pool.size());
+
+        pool.free(alloc);
+    }
+}
+
+namespace ObjectPool_ThreadSafe_Benchmark {
+
+    struct Particle
+    {
+        double m_x, m_y, m_z;
+        double m_mass;
+    };
+
+    static constexpr int MaxThreads = 16;
+    static constexpr int Batch = 8;
+    static constexpr int Capacity = MaxThreads * Batch;
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 20'000;       // debug
+#else
+    static constexpr int Rounds = 500'000;      // release
+#endif
+
+    // each thread acquires 'Batch' objects and releases them again, 'Rounds' times
+    template <typename TWorker>
+    static double runThreads(int numThreads, TWorker worker)
+    {
+        std::vector<std::thread> threads;
+
+        const auto begin{ std::chrono::steady_clock::now() };
+
+        for (int i{}; i != numThreads; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        const auto end{ std::chrono::steady_clock::now() };
+        const std::chrono::duration<double> seconds{ end - begin };
+
+        // allocations and deallocations per second
+        return 2.0 * numThreads * Rounds * Batch / seconds.count();
+    }
+
+    static double benchmarkIndexPool(int numThreads)
+    {
+        Pool<Particle> pool;
+
+        std::allocator<Particle> alloc;
+        pool.allocate(alloc, Capacity);
+
+        double opsPerSec = runThreads(numThreads, [&] () {
+
+            std::array<int, Batch> indices{};
+
+            for (int round{}; round != Rounds; ++round) {
+                for (auto& index : indices) {
+                    index = pool.emplace(1.0, 2.0, 3.0, 4.0).second;
+                }
+                for (auto index : indices) {
+                    pool.erase(index);
+                }
+            }
+        });
+
+        pool.free(alloc);
+        return opsPerSec;
+    }
+
+    static double benchmarkPointerPool(int numThreads)
+    {
+        auto pool{ std::make_unique<FixedSizeObjectPoolThreadSafe::ObjectPool<Particle, Capacity>>() };
+
+        return runThreads(numThreads, [&] () {
+
+            std::array<Particle*, Batch> pointers{};
+
+            for (int round{}; round != Rounds; ++round) {
+                for (auto& ptr : pointers) {
+                    ptr = pool->construct(1.0, 2.0, 3.0, 4.0);
+                }
+                for (auto ptr : pointers) {
+                    pool->destroy(ptr);
+                }
+            }
+        });
+    }
+
+    static void main_object_pool_thread_safe_20()
+    {
+        std::println("Throughput [million ops/sec] - batches of {} objects", Batch);
+        std::println("{:>8}{:>24}{:>24}", "Threads", "Pool (GuardedIndex)", "Sharded ObjectPool");
+
+        const int maxThreads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, MaxThreads);
+
+        for (int numThreads{ 1 }; numThreads <= maxThreads; numThreads *= 2) {
+
+            double indexPool{ benchmarkIndexPool(numThreads) };
+            double pointerPool{ benchmarkPointerPool(numThreads) };
+
+            std::println("{:>8}{:>24.2f}{:>24.2f}", numThreads, indexPool / 1'000'000.0, pointerPool / 1'000'000.0);
+        }
+    }
 }
 
 void main_object_pool_thread_safe_02()
 {
-    using namespace ObjectPool_ThreadSafe_SimpleTest;
+    ObjectPool_ThreadSafe_SimpleTest::main_object_pool_thread_safe_01();
+    ObjectPool_ThreadSafe_SimpleTest::main_object_pool_thread_safe_02();
+
+    ObjectPool_ThreadSafe_StressTest::main_object_pool_thread_safe_10();
 
-    main_object_pool_thread_safe_01();
+    ObjectPool_ThreadSafe_Benchmark::main_object_pool_thread_safe_20();
 }
 
 // ===========================================================================
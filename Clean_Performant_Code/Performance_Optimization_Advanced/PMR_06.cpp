@@ -5,6 +5,7 @@
 #include "../LoggerUtility/ScopedTimer.h"
 
 #include "PMR_DumpBuffer.h"
+#include "PMR_FixedArenaResource.h"
 
 #include <array>
 #include <cstddef>
@@ -81,81 +82,7 @@ static void test_pmr_06_01_logging()
 
 // =====================================================================================
 // Second example: Implementation of an Arena-based memory manager
-
-class FixedArenaResource : public std::pmr::memory_resource
-{
-private:
-    std::uint8_t* m_begin;
-    std::uint8_t* m_current;
-    std::uint8_t* m_end;
-
-public:
-    FixedArenaResource(void* buffer, std::size_t size) noexcept :
-        m_begin{ static_cast<std::uint8_t*>(buffer) },
-        m_current{ m_begin },
-        m_end{ m_begin + size }
-    {
-    }
-
-    void reset() noexcept
-    {
-        m_current = m_begin;
-    }
-
-    std::size_t used() const noexcept
-    {
-        return static_cast<std::size_t>(m_current - m_begin);
-    }
-
-    std::size_t capacity() const noexcept
-    {
-        return static_cast<std::size_t>(m_end - m_begin);
-    }
-
-protected:
-    void* do_allocate(std::size_t bytes, std::size_t alignment) override
-    {
-        std::uint8_t* aligned{ alignAddress(m_current, alignment) };
-
-        if (aligned + bytes > m_end) {
-            throw std::bad_alloc();  // no upstream resource
-        }
-
-        m_current = aligned + bytes;
-        return aligned;
-    }
-
-    void do_deallocate(void*, std::size_t, std::size_t) override
-    {
-        // Arena based behaviour - no deallocation
-    }
-
-    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
-    {
-        return this == &other;
-    }
-
-private:
-    static std::uint8_t* alignAddress(std::uint8_t* ptr, std::size_t alignment)
-    {
-        auto addr{ reinterpret_cast<std::uintptr_t>(ptr) };
-        auto aligned{ (addr + alignment - 1) & ~(alignment - 1) };
-        return reinterpret_cast<std::uint8_t*>(aligned);
-    }
-
-    static std::uint8_t* alignAddressModulo(std::uint8_t* ptr, std::size_t alignment)
-    {
-        // If you find the bitmask logic difficult to read, you can use modulo.
-        // It's slightly slower, but often easier to understand.
-
-        auto addr{ reinterpret_cast<std::uintptr_t>(ptr) };
-        auto remainder{ addr % alignment };
-        if (remainder != 0) {
-            addr += (alignment - remainder);
-        }
-        return reinterpret_cast<std::uint8_t*>(addr);
-    }
-};
+// (class FixedArenaResource - see PMR_FixedArenaResource.h)
 
 // =====================================================================================
 
@@ -4,11 +4,15 @@
 
 #include "../LoggerUtility/ScopedTimer.h"
 
+#include "StringFlatMap.h"
+
 #include <algorithm>
 #include <cstddef>
 #include <fstream>
 #include <memory_resource>
 #include <print>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -358,6 +362,108 @@ static void test_pmr_09_04_histogram_pmr()
     std::println();
 }
 
+// =====================================================================================
+// Histogram example: flat, open addressing map - lookup by std::string_view
+
+class HistogramFlat
+{
+private:
+    StringFlatMapping::StringFlatMap<std::size_t> m_frequenciesMap;
+    std::string                                   m_folded;   // reused buffer for capitalized words
+
+public:
+    HistogramFlat(const std::pmr::polymorphic_allocator<>& alloc = {})
+        : m_frequenciesMap{ alloc }
+    {
+    }
+
+    void add(std::string_view word) {
+        // no temporary string: the word is a view into the line
+        ++m_frequenciesMap[word];
+    }
+
+    void printTopScore(std::size_t top) const {
+
+        std::vector<std::pair<std::string_view, std::size_t>> popular(m_frequenciesMap.begin(), m_frequenciesMap.end());
+
+        top = std::min(top, popular.size());
+
+        std::partial_sort(popular.begin(), popular.begin() + top, popular.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; }
+        );
+
+        for (std::size_t n{}; n != top; ++n) {
+            std::println("{}: {}", popular[n].first, popular[n].second);
+        }
+    }
+
+    void readWords() {
+
+        std::string m_fileName{ "LoremIpsumHuge.txt" };
+
+        if (m_fileName.empty()) {
+            std::println("No Filename specified!");
+            return;
+        }
+
+        std::ifstream file{ m_fileName.data() };
+        if (!file.good()) {
+            std::println("File not found!");
+            return;
+        }
+
+        std::println("File {}", m_fileName);
+        std::println("Starting [Flat Map] ...");
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            // process single line
+            std::string_view sv{ line };
+
+            std::size_t begin{};
+            std::size_t end{};
+
+            while (end != sv.size()) {
+
+                while (std::isalpha(sv[end]))
+                    ++end;
+
+                std::string_view word{ sv.substr(begin, end - begin) };
+
+                if (!word.empty() && std::isupper(word[0])) {
+                    m_folded.assign(word);
+                    m_folded[0] = static_cast<char>(std::tolower(m_folded[0]));
+                    word = m_folded;
+                }
+
+                add(word);
+
+                while (end != sv.size() && (sv[end] == ' ' || sv[end] == '.' || sv[end] == ','))
+                    ++end;
+
+                begin = end;
+            }
+        }
+
+        std::println("Done Reading Dictionary");
+    }
+};
+
+static void test_pmr_09_04_histogram_flat()
+{
+    std::pmr::unsynchronized_pool_resource res;
+    HistogramFlat histo{ &res };
+
+    {
+        ScopedTimer watch{};
+        histo.readWords();
+        histo.printTopScore(TopWords);
+    }
+
+    std::println();
+}
+
 // =====================================================================================
 
 void test_pmr_09()
@@ -371,6 +477,7 @@ void test_pmr_09()
 
     test_pmr_09_04_histogram();
     test_pmr_09_04_histogram_pmr();
+    test_pmr_09_04_histogram_flat();
 }
 
 // =====================================================================================
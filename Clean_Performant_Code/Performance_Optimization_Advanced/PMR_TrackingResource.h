@@ -0,0 +1,63 @@
+// ===========================================================================
+// PMR_TrackingResource.h // Polymorphic Memory Resources
+// ===========================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+class TrackingResource : public std::pmr::memory_resource
+{
+private:
+    std::pmr::memory_resource* m_upstream;
+
+    std::size_t m_countAllocations;
+    std::size_t m_countDeallocations;
+    std::size_t m_bytesAllocated;
+
+public:
+    TrackingResource(std::pmr::memory_resource* upstream)
+        : m_upstream{ upstream }, m_countAllocations{ 0 },
+        m_countDeallocations{ 0 }, m_bytesAllocated{ 0 }
+    {
+    }
+
+public:
+    std::size_t getAllocations() const {
+        return m_countAllocations;
+    }
+
+    std::size_t getDeallocations() const {
+        return m_countDeallocations;
+    }
+
+    std::size_t getBytesAllocated() const {
+        return m_bytesAllocated;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++m_countAllocations;
+        m_bytesAllocated += bytes;
+
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        ++m_countDeallocations;
+
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
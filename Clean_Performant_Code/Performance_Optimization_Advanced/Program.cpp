@@ -15,8 +15,26 @@ extern void main_fixed_block_allocator_new_delete();
 extern void main_object_pool_fixed_size();
 extern void main_object_pool_dynamic_size();
 extern void main_object_pool_thread_safe();
+extern void main_object_pool_thread_safe_02();
+extern void main_object_pool_persistent();
+extern void main_object_pool_bitmap();
+extern void main_slot_map();
+extern void main_object_pool_adaptive();
+
+extern void main_allocator_benchmark_suite();
 
 extern void main_cow_string();
+extern void main_cow_string_thread_safe();
+extern void main_cow_string_builder();
+
+extern void main_string_interner();
+extern void main_word_frequency_engine();
+extern void main_simd_tokenizer();
+extern void main_string_flat_map();
+extern void main_heavy_hitters();
+extern void main_incremental_word_frequency();
+extern void main_ngram_engine();
+extern void main_inverted_index();
 
 extern void test_pmr_02();
 extern void test_pmr_03();
@@ -42,8 +60,26 @@ int main()
     //main_object_pool_fixed_size();
     //main_object_pool_dynamic_size();
     //main_object_pool_thread_safe();
+    //main_object_pool_thread_safe_02();
+    //main_object_pool_persistent();
+    //main_object_pool_bitmap();
+    //main_slot_map();
+    //main_object_pool_adaptive();
+
+    //main_allocator_benchmark_suite();
 
     //main_cow_string();
+    //main_cow_string_thread_safe();
+    //main_cow_string_builder();
+
+    //main_string_interner();
+    //main_word_frequency_engine();
+    //main_simd_tokenizer();
+    //main_string_flat_map();
+    //main_heavy_hitters();
+    //main_incremental_word_frequency();
+    //main_ngram_engine();
+    //main_inverted_index();
 
     test_pmr_02();
     //test_pmr_03();
@@ -0,0 +1,109 @@
+// ===========================================================================
+// SimdTokenizer.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SimdTokenizer {
+
+    // Words are maximal runs of ASCII letters ('A'..'Z', 'a'..'z'),
+    // every other byte separates them - no locale, no std::isalpha.
+    //
+    // The text is classified in blocks of 64 bytes: one bit per byte, set for letters.
+    // The classification uses the widest instruction set of the CPU (selected at runtime):
+    //
+    //   AVX-512BW:  one 64 byte comparison, the result is the mask
+    //   AVX2:       two 32 byte comparisons, 'movemask' builds the mask
+    //   SSE2:       four 16 byte comparisons
+    //   Scalar:     a table lookup per byte
+    //
+    // The word boundaries are the 0->1 and 1->0 transitions of the mask,
+    // they are extracted with 'countr_zero' - no branch per byte.
+
+    enum class Level { Scalar, SSE2, AVX2, AVX512 };
+
+    static constexpr std::size_t BlockSize{ 64 };
+
+    // the best level supported by the CPU (and the operating system)
+    Level detectLevel();
+
+    // the level in use - by default the detected one
+    Level activeLevel();
+
+    // selects a level (for comparisons) - a level above 'detectLevel()' is lowered to it
+    Level setLevel(Level level);
+
+    std::string_view levelName(Level level);
+
+    // bit i is set, if byte i of the block is a letter - 'length' <= 64 (bits above 'length' are zero)
+    std::uint64_t letterMask(const char* block, std::size_t length);
+
+    // converts 'A'..'Z' to 'a'..'z' in place, all other bytes are unchanged
+    void toLowerAscii(char* text, std::size_t length);
+
+    // calls 'func(std::string_view)' for each word of 'text' - the views refer to 'text'
+    template <typename TFunc>
+    void forEachWord(std::string_view text, TFunc&& func)
+    {
+        const char* data{ text.data() };
+        const std::size_t size{ text.size() };
+
+        std::size_t wordBegin{};
+        bool inWord{ false };
+
+        for (std::size_t base{}; base < size; base += BlockSize) {
+
+            const std::size_t length{ (size - base < BlockSize) ? size - base : BlockSize };
+
+            const std::uint64_t letters{ letterMask(data + base, length) };
+
+            // bit i of 'previous': byte i - 1 is a letter (bit 0: the last byte of the previous block)
+            const std::uint64_t previous{ (letters << 1) | (inWord ? 1u : 0u) };
+
+            std::uint64_t starts{ letters & ~previous };
+            std::uint64_t ends{ ~letters & previous };
+
+            // a word ending at the end of the text is completed below
+            if (length < BlockSize) {
+                ends &= (std::uint64_t{ 1 } << length) - 1;
+            }
+
+            // starts and ends alternate
+            while (true) {
+
+                if (!inWord) {
+                    if (starts == 0) {
+                        break;
+                    }
+
+                    wordBegin = base + std::countr_zero(starts);
+                    starts &= starts - 1;
+                    inWord = true;
+                }
+
+                if (ends == 0) {
+                    break;
+                }
+
+                const std::size_t wordEnd{ base + std::countr_zero(ends) };
+                ends &= ends - 1;
+                inWord = false;
+
+                func(std::string_view{ data + wordBegin, wordEnd - wordBegin });
+            }
+        }
+
+        if (inWord) {
+            func(std::string_view{ data + wordBegin, size - wordBegin });
+        }
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
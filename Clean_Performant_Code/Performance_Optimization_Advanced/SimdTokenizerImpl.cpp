@@ -0,0 +1,315 @@
+// ===========================================================================
+// SimdTokenizerImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "SimdTokenizer.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIMD_TOKENIZER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang compile a function for an instruction set only on request,
+// MSVC accepts all intrinsics in every function
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMD_TOKENIZER_TARGET(isa)
+#else
+#define SIMD_TOKENIZER_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace SimdTokenizer {
+
+    using MaskFunc = std::uint64_t(*)(const char*);           // a full block of 64 bytes
+    using LowerFunc = void(*)(char*, std::size_t);
+
+    // =======================================================================
+    // scalar
+
+    static constexpr std::array<bool, 256> LetterTable = [] () {
+        std::array<bool, 256> table{};
+        for (int ch{ 'a' }; ch <= 'z'; ++ch) {
+            table[ch] = true;
+            table[ch - 'a' + 'A'] = true;
+        }
+        return table;
+    } ();
+
+    static std::uint64_t letterMaskScalar(const char* block)
+    {
+        std::uint64_t mask{};
+
+        for (std::size_t i{}; i != BlockSize; ++i) {
+            mask |= std::uint64_t{ LetterTable[static_cast<unsigned char>(block[i])] } << i;
+        }
+
+        return mask;
+    }
+
+    static void toLowerScalar(char* text, std::size_t length)
+    {
+        for (std::size_t i{}; i != length; ++i) {
+            if (text[i] >= 'A' && text[i] <= 'Z') {
+                text[i] = static_cast<char>(text[i] + ('a' - 'A'));
+            }
+        }
+    }
+
+#if defined(SIMD_TOKENIZER_X86)
+
+    // =======================================================================
+    // SSE2 - there is no unsigned byte comparison:
+    // 'x - lower' in [0, 26) is tested as the signed comparison 'x - lower - 128 < 26 - 128'
+
+    static __m128i inRange(__m128i bytes, char lower)
+    {
+        const __m128i shifted{ _mm_add_epi8(bytes, _mm_set1_epi8(static_cast<char>(0x80 - lower))) };
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+    }
+
+    // 'ch | 0x20' maps 'A'..'Z' onto 'a'..'z', no other byte lands there
+    static __m128i isLetter(__m128i bytes)
+    {
+        return inRange(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), 'a');
+    }
+
+    static std::uint64_t letterMaskSSE2(const char* block)
+    {
+        std::uint64_t mask{};
+
+        for (std::size_t i{}; i != BlockSize; i += 16) {
+            const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i)) };
+            mask |= std::uint64_t{ static_cast<std::uint16_t>(_mm_movemask_epi8(isLetter(bytes))) } << i;
+        }
+
+        return mask;
+    }
+
+    static void toLowerSSE2(char* text, std::size_t length)
+    {
+        std::size_t i{};
+
+        for (; i + 16 <= length; i += 16) {
+            __m128i* pos{ reinterpret_cast<__m128i*>(text + i) };
+            const __m128i bytes{ _mm_loadu_si128(pos) };
+            const __m128i upper{ inRange(bytes, 'A') };
+            _mm_storeu_si128(pos, _mm_add_epi8(bytes, _mm_and_si128(upper, _mm_set1_epi8(0x20))));
+        }
+
+        toLowerScalar(text + i, length - i);
+    }
+
+    // =======================================================================
+    // AVX2 - the same comparisons with 32 bytes
+
+    SIMD_TOKENIZER_TARGET("avx2")
+    static __m256i inRange(__m256i bytes, char lower)
+    {
+        const __m256i shifted{ _mm256_add_epi8(bytes, _mm256_set1_epi8(static_cast<char>(0x80 - lower))) };
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 26)), shifted);
+    }
+
+    SIMD_TOKENIZER_TARGET("avx2")
+    static std::uint64_t letterMaskAVX2(const char* block)
+    {
+        const __m256i caseBit{ _mm256_set1_epi8(0x20) };
+
+        const __m256i low{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)) };
+        const __m256i high{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)) };
+
+        const auto lowMask{ static_cast<std::uint32_t>(_mm256_movemask_epi8(inRange(_mm256_or_si256(low, caseBit), 'a'))) };
+        const auto highMask{ static_cast<std::uint32_t>(_mm256_movemask_epi8(inRange(_mm256_or_si256(high, caseBit), 'a'))) };
+
+        return (std::uint64_t{ highMask } << 32) | lowMask;
+    }
+
+    SIMD_TOKENIZER_TARGET("avx2")
+    static void toLowerAVX2(char* text, std::size_t length)
+    {
+        std::size_t i{};
+
+        for (; i + 32 <= length; i += 32) {
+            __m256i* pos{ reinterpret_cast<__m256i*>(text + i) };
+            const __m256i bytes{ _mm256_loadu_si256(pos) };
+            const __m256i upper{ inRange(bytes, 'A') };
+            _mm256_storeu_si256(pos, _mm256_add_epi8(bytes, _mm256_and_si256(upper, _mm256_set1_epi8(0x20))));
+        }
+
+        toLowerScalar(text + i, length - i);
+    }
+
+    // =======================================================================
+    // AVX-512BW - unsigned comparisons into mask registers, masked addition
+
+    SIMD_TOKENIZER_TARGET("avx512f,avx512bw")
+    static std::uint64_t letterMaskAVX512(const char* block)
+    {
+        const __m512i bytes{ _mm512_loadu_si512(block) };
+        const __m512i folded{ _mm512_sub_epi8(_mm512_or_si512(bytes, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a')) };
+
+        return _mm512_cmplt_epu8_mask(folded, _mm512_set1_epi8(26));
+    }
+
+    SIMD_TOKENIZER_TARGET("avx512f,avx512bw")
+    static void toLowerAVX512(char* text, std::size_t length)
+    {
+        std::size_t i{};
+
+        for (; i + 64 <= length; i += 64) {
+            const __m512i bytes{ _mm512_loadu_si512(text + i) };
+            const __mmask64 upper{ _mm512_cmplt_epu8_mask(_mm512_sub_epi8(bytes, _mm512_set1_epi8('A')), _mm512_set1_epi8(26)) };
+            _mm512_storeu_si512(text + i, _mm512_mask_add_epi8(bytes, upper, bytes, _mm512_set1_epi8(0x20)));
+        }
+
+        toLowerScalar(text + i, length - i);
+    }
+
+#endif
+
+    // =======================================================================
+    // runtime dispatch
+
+    static Level detect()
+    {
+#if defined(SIMD_TOKENIZER_X86)
+#if defined(_MSC_VER)
+        int regs[4]{};
+
+        __cpuid(regs, 0);
+        const int maxLeaf{ regs[0] };
+
+        __cpuid(regs, 1);
+        const bool osxsave{ (regs[2] & (1 << 27)) != 0 };
+        const bool sse2{ (regs[3] & (1 << 26)) != 0 };
+
+        if (!sse2) {
+            return Level::Scalar;
+        }
+
+        if (!osxsave || maxLeaf < 7) {
+            return Level::SSE2;
+        }
+
+        // the operating system has to save the AVX (and AVX-512) registers
+        const unsigned long long xcr0{ _xgetbv(0) };
+
+        __cpuidex(regs, 7, 0);
+        const bool avx2{ (regs[1] & (1 << 5)) != 0 && (xcr0 & 0x06) == 0x06 };
+        const bool avx512{ (regs[1] & (1 << 16)) != 0 && (regs[1] & (1 << 30)) != 0 && (xcr0 & 0xE6) == 0xE6 };
+#else
+        __builtin_cpu_init();
+
+        if (!__builtin_cpu_supports("sse2")) {
+            return Level::Scalar;
+        }
+
+        const bool avx2{ __builtin_cpu_supports("avx2") != 0 };
+        const bool avx512{ __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("avx512bw") != 0 };
+#endif
+        if (avx512) {
+            return Level::AVX512;
+        }
+
+        return avx2 ? Level::AVX2 : Level::SSE2;
+#else
+        return Level::Scalar;
+#endif
+    }
+
+    struct Functions
+    {
+        MaskFunc   m_letterMask;
+        LowerFunc  m_toLower;
+    };
+
+    static Functions functionsOf(Level level)
+    {
+        switch (level)
+        {
+#if defined(SIMD_TOKENIZER_X86)
+        case Level::AVX512:
+            return { letterMaskAVX512, toLowerAVX512 };
+        case Level::AVX2:
+            return { letterMaskAVX2, toLowerAVX2 };
+        case Level::SSE2:
+            return { letterMaskSSE2, toLowerSSE2 };
+#endif
+        default:
+            return { letterMaskScalar, toLowerScalar };
+        }
+    }
+
+    static const Level g_detected{ detect() };
+
+    static std::atomic<Level> g_level{ g_detected };
+    static std::atomic<MaskFunc> g_letterMask{ functionsOf(g_detected).m_letterMask };
+    static std::atomic<LowerFunc> g_toLower{ functionsOf(g_detected).m_toLower };
+
+    Level detectLevel()
+    {
+        return g_detected;
+    }
+
+    Level activeLevel()
+    {
+        return g_level.load(std::memory_order_relaxed);
+    }
+
+    Level setLevel(Level level)
+    {
+        if (level > g_detected) {
+            level = g_detected;
+        }
+
+        const Functions functions{ functionsOf(level) };
+
+        g_letterMask.store(functions.m_letterMask, std::memory_order_relaxed);
+        g_toLower.store(functions.m_toLower, std::memory_order_relaxed);
+        g_level.store(level, std::memory_order_relaxed);
+
+        return level;
+    }
+
+    std::string_view levelName(Level level)
+    {
+        switch (level)
+        {
+        case Level::AVX512: return "AVX-512BW";
+        case Level::AVX2:   return "AVX2";
+        case Level::SSE2:   return "SSE2";
+        default:            return "Scalar";
+        }
+    }
+
+    // =======================================================================
+    // public interface
+
+    std::uint64_t letterMask(const char* block, std::size_t length)
+    {
+        const MaskFunc func{ g_letterMask.load(std::memory_order_relaxed) };
+
+        if (length == BlockSize) {
+            return func(block);
+        }
+
+        // the tail of the text: no read beyond its end - a zero byte is no letter
+        alignas(64) char padded[BlockSize]{};
+        std::memcpy(padded, block, length);
+        return func(padded);
+    }
+
+    void toLowerAscii(char* text, std::size_t length)
+    {
+        g_toLower.load(std::memory_order_relaxed)(text, length);
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,214 @@
+// ===========================================================================
+// SimdTokenizer_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "SimdTokenizer.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <print>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SimdTokenizer_SimpleTest {
+
+    using namespace SimdTokenizer;
+
+    static void main_simd_tokenizer_01()
+    {
+        std::println("Detected: {}", levelName(detectLevel()));
+
+        std::string_view text{ "Lorem ipsum dolor sit amet, consectetur\tadipiscing elit; sed-do (eiusmod) tempor 42times." };
+
+        forEachWord(text, [] (std::string_view word) {
+            std::print("[{}] ", word);
+        });
+        std::println();
+
+        std::string lower{ text };
+        toLowerAscii(lower.data(), lower.size());
+        std::println("{}", lower);
+    }
+
+    // the reference: the byte-wise loop
+    static std::vector<std::string_view> splitBytewise(std::string_view text)
+    {
+        auto isLetter = [] (char ch) {
+            return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+        };
+
+        std::vector<std::string_view> words;
+
+        std::size_t pos{};
+        while (pos != text.size()) {
+
+            while (pos != text.size() && !isLetter(text[pos]))
+                ++pos;
+
+            const std::size_t begin{ pos };
+
+            while (pos != text.size() && isLetter(text[pos]))
+                ++pos;
+
+            if (pos != begin) {
+                words.push_back(text.substr(begin, pos - begin));
+            }
+        }
+
+        return words;
+    }
+
+    // all levels against the reference - random bytes of random length (all block boundaries)
+    static void main_simd_tokenizer_02()
+    {
+        std::mt19937 generator{ 4711 };
+        std::uniform_int_distribution<int> byteDistribution{ 0, 255 };
+        std::uniform_int_distribution<int> letterDistribution{ 0, 3 };
+
+        for (Level level : { Level::Scalar, Level::SSE2, Level::AVX2, Level::AVX512 }) {
+
+            const Level used{ setLevel(level) };
+
+            bool ok{ true };
+
+            for (std::size_t length{}; length != 300; ++length) {
+
+                // mostly letters, so that words cross the block boundaries
+                std::string text(length, ' ');
+                for (char& ch : text) {
+                    ch = (letterDistribution(generator) != 0) ? static_cast<char>('a' + byteDistribution(generator) % 26) : static_cast<char>(byteDistribution(generator));
+                }
+
+                std::vector<std::string_view> words;
+                forEachWord(text, [&] (std::string_view word) { words.push_back(word); });
+
+                std::string lower{ text };
+                toLowerAscii(lower.data(), lower.size());
+
+                std::string expected{ text };
+                for (char& ch : expected) {
+                    if (ch >= 'A' && ch <= 'Z') ch = static_cast<char>(ch - 'A' + 'a');
+                }
+
+                ok = ok && words == splitBytewise(text) && lower == expected;
+            }
+
+            std::println("{:<10} (used: {:<10}): {}", levelName(level), levelName(used), ok ? "ok" : "FAILED");
+        }
+
+        setLevel(detectLevel());
+    }
+}
+
+namespace SimdTokenizer_Benchmark {
+
+    using namespace SimdTokenizer;
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 1;         // debug
+#else
+    static constexpr int Rounds = 20;        // release
+#endif
+
+    static std::string readFile(const char* fileName)
+    {
+        std::ifstream file{ fileName, std::ios::binary };
+
+        file.seekg(0, std::ios::end);
+        std::string contents(static_cast<std::size_t>(file.tellg()), '\0');
+        file.seekg(0, std::ios::beg);
+        file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+        return contents;
+    }
+
+    template <typename TFunc>
+    static void measure(std::string_view name, std::size_t bytes, TFunc func)
+    {
+        std::size_t words{};
+
+        const auto begin{ std::chrono::steady_clock::now() };
+
+        for (int round{}; round != Rounds; ++round) {
+            words += func();
+        }
+
+        const std::chrono::duration<double> seconds{ std::chrono::steady_clock::now() - begin };
+
+        std::println("{:<24}{:>10} words {:>10.2f} GB/s", name, words / Rounds,
+            bytes * Rounds / seconds.count() / (1'024.0 * 1'024.0 * 1'024.0));
+    }
+
+    static void main_simd_tokenizer_20()
+    {
+        const std::string text{ readFile("LoremIpsumHuge.txt") };
+
+        std::println("LoremIpsumHuge.txt: {} bytes, {} rounds", text.size(), Rounds);
+
+        // the loop of TextfileStatistics - std::isalpha per byte
+        measure("std::isalpha", text.size(), [&] () {
+            std::size_t words{};
+            std::size_t pos{};
+            while (pos != text.size()) {
+                while (pos != text.size() && !std::isalpha(static_cast<unsigned char>(text[pos])))
+                    ++pos;
+                const std::size_t begin{ pos };
+                while (pos != text.size() && std::isalpha(static_cast<unsigned char>(text[pos])))
+                    ++pos;
+                words += (pos != begin);
+            }
+            return words;
+        });
+
+        for (Level level : { Level::Scalar, Level::SSE2, Level::AVX2, Level::AVX512 }) {
+
+            if (level > detectLevel()) {
+                continue;
+            }
+
+            setLevel(level);
+
+            measure(std::string{ "forEachWord - " } + std::string{ levelName(level) }, text.size(), [&] () {
+                std::size_t words{};
+                forEachWord(text, [&] (std::string_view) { ++words; });
+                return words;
+            });
+        }
+
+        std::string copy{ text };
+
+        for (Level level : { Level::Scalar, Level::SSE2, Level::AVX2, Level::AVX512 }) {
+
+            if (level > detectLevel()) {
+                continue;
+            }
+
+            setLevel(level);
+
+            measure(std::string{ "toLowerAscii - " } + std::string{ levelName(level) }, text.size(), [&] () {
+                toLowerAscii(copy.data(), copy.size());
+                return std::size_t{};
+            });
+        }
+
+        setLevel(detectLevel());
+    }
+}
+
+void main_simd_tokenizer()
+{
+    SimdTokenizer_SimpleTest::main_simd_tokenizer_01();
+    SimdTokenizer_SimpleTest::main_simd_tokenizer_02();
+
+    SimdTokenizer_Benchmark::main_simd_tokenizer_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,272 @@
+// ===========================================================================
+// SlotMap.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace GenerationalSlotMap {
+
+    // Handle of an object in a SlotMap: index of its slot and generation of the slot.
+    // Each time an object is erased, the generation of its slot is incremented,
+    // so a stale handle doesn't find the next object stored in that slot.
+    struct Handle
+    {
+        std::uint32_t m_index{ 0 };
+        std::uint32_t m_generation{ 0 };
+
+        friend bool operator==(const Handle&, const Handle&) = default;
+    };
+
+    // Slot map: stable handles, densely stored objects.
+    //
+    //  * The objects live in a contiguous array, without holes:
+    //    erase() moves the last object into the gap (swap-and-pop),
+    //    so iterating all objects is a plain linear scan.
+    //
+    //  * The slots are the indirection between handles and objects:
+    //    a slot holds its generation and the position of its object
+    //    in the dense array. Free slots form a singly linked list.
+    //
+    //  * Slot 0 is never handed out and its generation never matches
+    //    a handle: the default constructed (null) handle is invalid,
+    //    and validating a handle takes a single comparison.
+
+    template <typename T, typename TAllocator = std::allocator<T>>
+    class SlotMap final
+    {
+    public:
+        using value_type = T;
+        using iterator = typename std::vector<T, TAllocator>::iterator;
+        using const_iterator = typename std::vector<T, TAllocator>::const_iterator;
+
+    private:
+        struct Slot
+        {
+            std::uint32_t m_generation;
+            std::uint32_t m_position;   // position in the dense array - or next free slot
+        };
+
+        using SlotAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<Slot>;
+        using IndexAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<std::uint32_t>;
+
+        static constexpr std::uint32_t NullIndex{ 0 };
+
+    public:
+        // c'tor/d'tor
+        SlotMap();
+        explicit SlotMap(const TAllocator& allocator);
+        ~SlotMap() = default;
+
+        // no copy, move is fine (handles refer to the slots, not to the container)
+        SlotMap(const SlotMap&) = delete;
+        SlotMap& operator=(const SlotMap&) = delete;
+        SlotMap(SlotMap&&) noexcept = default;
+        SlotMap& operator=(SlotMap&&) noexcept = default;
+
+        // modifiers
+        template <typename ... TArgs>
+        Handle emplace(TArgs&&... args);
+
+        Handle insert(const T& value) { return emplace(value); }
+        Handle insert(T&& value) { return emplace(std::move(value)); }
+
+        bool erase(Handle handle);
+        void clear() noexcept;
+        void reserve(std::size_t capacity);
+
+        // lookup - nullptr, if the handle is stale
+        T* get(Handle handle) noexcept;
+        const T* get(Handle handle) const noexcept;
+        bool contains(Handle handle) const noexcept;
+
+        // dense storage
+        iterator begin() noexcept { return m_objects.begin(); }
+        iterator end() noexcept { return m_objects.end(); }
+        const_iterator begin() const noexcept { return m_objects.begin(); }
+        const_iterator end() const noexcept { return m_objects.end(); }
+
+        std::span<T> values() noexcept { return m_objects; }
+        std::span<const T> values() const noexcept { return m_objects; }
+
+        // handle of the object at 'position' in the dense array
+        Handle handleAt(std::size_t position) const noexcept;
+
+        std::size_t size() const noexcept { return m_objects.size(); }
+        bool empty() const noexcept { return m_objects.empty(); }
+
+    private:
+        const Slot& slot(Handle handle) const noexcept { return m_slots[handle.m_index]; }
+
+        // room for one more element - growing geometrically, as push_back does
+        template <typename TVector>
+        static void reserveOneMore(TVector& vector);
+
+        // member data
+        std::vector<T, TAllocator>                  m_objects;     // dense array
+        std::vector<std::uint32_t, IndexAllocator>  m_owners;      // slot of each object in the dense array
+        std::vector<Slot, SlotAllocator>            m_slots;
+        std::uint32_t                               m_freeSlot;    // head of the list of free slots
+    };
+
+    // =======================================================================
+    // c'tor
+
+    template <typename T, typename TAllocator>
+    inline SlotMap<T, TAllocator>::SlotMap()
+        : SlotMap{ TAllocator{} }
+    {
+    }
+
+    template <typename T, typename TAllocator>
+    inline SlotMap<T, TAllocator>::SlotMap(const TAllocator& allocator)
+        : m_objects{ allocator }, m_owners{ IndexAllocator{ allocator } }, m_slots{ SlotAllocator{ allocator } }, m_freeSlot{ NullIndex }
+    {
+        // sentinel slot: no handle has generation 'max'
+        // (the slot is never used, so its generation never changes)
+        m_slots.push_back(Slot{ std::numeric_limits<std::uint32_t>::max(), 0 });
+    }
+
+    // =======================================================================
+    // modifiers
+
+    template <typename T, typename TAllocator>
+    template <typename ... TArgs>
+    inline Handle SlotMap<T, TAllocator>::emplace(TArgs&&... args)
+    {
+        if (m_objects.size() == std::numeric_limits<std::uint32_t>::max() - 1) {
+            throw std::bad_alloc{};
+        }
+
+        // make sure, that nothing can throw after the object has been constructed -
+        // but m_objects grows in emplace_back: 'args' may refer to an element of m_objects
+        reserveOneMore(m_owners);
+        if (m_freeSlot == NullIndex) {
+            reserveOneMore(m_slots);
+        }
+
+        const auto position{ static_cast<std::uint32_t>(m_objects.size()) };
+        m_objects.emplace_back(std::forward<TArgs>(args)...);
+
+        // take a free slot or append a new one
+        std::uint32_t index{ m_freeSlot };
+        if (index != NullIndex) {
+            m_freeSlot = m_slots[index].m_position;
+            m_slots[index].m_position = position;
+        }
+        else {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back(Slot{ 0, position });
+        }
+
+        m_owners.push_back(index);
+
+        return Handle{ index, m_slots[index].m_generation };
+    }
+
+    template <typename T, typename TAllocator>
+    inline bool SlotMap<T, TAllocator>::erase(Handle handle)
+    {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        Slot& erased{ m_slots[handle.m_index] };
+        const std::uint32_t position{ erased.m_position };
+        const std::uint32_t last{ static_cast<std::uint32_t>(m_objects.size() - 1) };
+
+        // swap-and-pop: the last object fills the gap
+        if (position != last) {
+            m_objects[position] = std::move(m_objects[last]);
+            m_owners[position] = m_owners[last];
+            m_slots[m_owners[position]].m_position = position;
+        }
+
+        m_objects.pop_back();
+        m_owners.pop_back();
+
+        // invalidate all handles of this slot and put it on the free list
+        ++erased.m_generation;
+        erased.m_position = m_freeSlot;
+        m_freeSlot = handle.m_index;
+
+        return true;
+    }
+
+    template <typename T, typename TAllocator>
+    inline void SlotMap<T, TAllocator>::clear() noexcept
+    {
+        // all slots become free - each one with a new generation
+        for (std::size_t i{}; i != m_owners.size(); ++i) {
+            Slot& slot{ m_slots[m_owners[i]] };
+            ++slot.m_generation;
+            slot.m_position = m_freeSlot;
+            m_freeSlot = m_owners[i];
+        }
+
+        m_objects.clear();
+        m_owners.clear();
+    }
+
+    template <typename T, typename TAllocator>
+    inline void SlotMap<T, TAllocator>::reserve(std::size_t capacity)
+    {
+        m_objects.reserve(capacity);
+        m_owners.reserve(capacity);
+        m_slots.reserve(capacity + 1);
+    }
+
+    template <typename T, typename TAllocator>
+    template <typename TVector>
+    inline void SlotMap<T, TAllocator>::reserveOneMore(TVector& vector)
+    {
+        if (vector.size() == vector.capacity()) {
+            vector.reserve(std::max<std::size_t>(16, 2 * vector.capacity()));
+        }
+    }
+
+    // =======================================================================
+    // lookup
+
+    template <typename T, typename TAllocator>
+    inline bool SlotMap<T, TAllocator>::contains(Handle handle) const noexcept
+    {
+        // Note: handles must originate from this map - the index isn't range checked
+        assert(handle.m_index < m_slots.size());
+
+        return slot(handle).m_generation == handle.m_generation;
+    }
+
+    template <typename T, typename TAllocator>
+    inline T* SlotMap<T, TAllocator>::get(Handle handle) noexcept
+    {
+        return contains(handle) ? &m_objects[slot(handle).m_position] : nullptr;
+    }
+
+    template <typename T, typename TAllocator>
+    inline const T* SlotMap<T, TAllocator>::get(Handle handle) const noexcept
+    {
+        return contains(handle) ? &m_objects[slot(handle).m_position] : nullptr;
+    }
+
+    template <typename T, typename TAllocator>
+    inline Handle SlotMap<T, TAllocator>::handleAt(std::size_t position) const noexcept
+    {
+        const std::uint32_t index{ m_owners[position] };
+        return Handle{ index, m_slots[index].m_generation };
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,244 @@
+// ===========================================================================
+// SlotMap_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+#include "../Person/Person.h"
+
+#include "ObjectPool_DynamicSize.h"
+#include "SlotMap.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace SlotMap_SimpleTest {
+
+    using namespace GenerationalSlotMap;
+
+    static void main_slot_map_01()
+    {
+        SlotMap<Person> persons;
+
+        Handle hans{ persons.emplace("Hans", "Mueller", static_cast<size_t>(30)) };
+        Handle susi{ persons.emplace("Susi", "Wagner", static_cast<size_t>(40)) };
+        Handle gerd{ persons.emplace("Gerd", "Meier", static_cast<size_t>(50)) };
+
+        // erasing 'hans' moves 'gerd' to the front of the dense array
+        persons.erase(hans);
+
+        for (const auto& person : persons) {
+            std::println("{} {} has age {}", person.getFirstname(), person.getLastname(), person.getAge());
+        }
+
+        // the slot of 'hans' is reused - but with a new generation
+        Handle sepp{ persons.emplace("Sepp", "Huber", static_cast<size_t>(60)) };
+
+        std::println("hans: slot {} generation {} - valid: {}", hans.m_index, hans.m_generation, persons.contains(hans));
+        std::println("sepp: slot {} generation {} - valid: {}", sepp.m_index, sepp.m_generation, persons.contains(sepp));
+        std::println("susi: {}", persons.get(susi)->getFirstname());
+        std::println("gerd: {}", persons.get(gerd)->getFirstname());
+        std::println("null handle valid: {}", persons.contains(Handle{}));
+    }
+
+    static void main_slot_map_02()
+    {
+        // dense storage comes from a memory resource
+        std::pmr::monotonic_buffer_resource resource{};
+
+        SlotMap<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>> words{ &resource };
+
+        std::vector<Handle> handles;
+        for (const char* word : { "one", "two", "three", "four", "five" }) {
+            handles.push_back(words.emplace(word));
+        }
+
+        words.erase(handles[1]);
+        words.erase(handles[3]);
+
+        for (std::size_t i{}; i != words.size(); ++i) {
+            Handle handle{ words.handleAt(i) };
+            std::println("[{}] slot {}: {}", i, handle.m_index, *words.get(handle));
+        }
+    }
+
+    static void main_slot_map_03()
+    {
+        // inserting a copy of an element of the map itself - the dense array is full,
+        // so it grows while the argument still refers to its old storage
+        constexpr std::size_t Capacity{ 16 };
+
+        SlotMap<std::string> words;
+        words.reserve(Capacity);
+
+        Handle handle{ words.emplace("a string, which is too long for the small string optimization") };
+
+        while (words.size() != Capacity) {
+            handle = words.insert(*words.get(handle));
+        }
+
+        Handle copy{ words.insert(*words.get(handle)) };
+
+        std::println("size {} - copy equal: {}", words.size(), *words.get(copy) == *words.get(handle));
+    }
+}
+
+namespace SlotMap_Benchmark {
+
+#ifdef _DEBUG
+    static constexpr std::size_t Ticks = 10;          // debug
+#else
+    static constexpr std::size_t Ticks = 100;         // release
+#endif
+
+    static constexpr std::size_t Entities = 1'000'000;
+    static constexpr std::size_t Churn = Entities / 20;
+
+    struct Particle
+    {
+        float m_x, m_y, m_z;
+        float m_vx, m_vy, m_vz;
+    };
+
+    static void update(Particle& particle)
+    {
+        particle.m_x += particle.m_vx;
+        particle.m_y += particle.m_vy;
+        particle.m_z += particle.m_vz;
+    }
+
+    // removes 'Churn' randomly chosen entities (swap-and-pop on the list of entities),
+    // then creates 'Churn' new ones
+    template <typename TEntities, typename TErase, typename TCreate>
+    static void churn(TEntities& entities, std::mt19937& generator, TErase erase, TCreate create)
+    {
+        for (std::size_t i{}; i != Churn; ++i) {
+            std::uniform_int_distribution<std::size_t> distribution{ 0, entities.size() - 1 };
+            auto& victim{ entities[distribution(generator)] };
+            erase(victim);
+            victim = std::move(entities.back());
+            entities.pop_back();
+        }
+
+        for (std::size_t i{}; i != Churn; ++i) {
+            entities.push_back(create());
+        }
+    }
+
+    // some rounds of churn scatter the entities, then the
+    // update loop over all entities and the churn are measured separately
+    static void main_slot_map_20()
+    {
+        std::println("{} entities, {} ticks, {} replaced per tick", Entities, Ticks, Churn);
+
+        std::println("DynamicSizeObjectPool - list of PooledPtr ...");
+        {
+            DynamicSizeObjectPool::ObjectPool<Particle> pool;
+            std::vector<DynamicSizeObjectPool::PooledPtr<Particle>> entities;
+            std::mt19937 generator{ 42 };
+
+            auto erase = [] (auto& particle) { particle.reset(); };
+            auto create = [&] () { return pool.acquireObject(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f); };
+
+            for (std::size_t i{}; i != Entities; ++i) {
+                entities.push_back(create());
+            }
+
+            for (std::size_t tick{}; tick != Ticks; ++tick) {
+                churn(entities, generator, erase, create);
+            }
+
+            std::println("Update:");
+            {
+                ScopedTimer watch{};
+
+                for (std::size_t tick{}; tick != Ticks; ++tick) {
+                    for (auto& particle : entities) {
+                        update(*particle);
+                    }
+                }
+            }
+
+            std::println("Erase / create:");
+            {
+                ScopedTimer watch{};
+
+                for (std::size_t tick{}; tick != Ticks; ++tick) {
+                    churn(entities, generator, erase, create);
+                }
+            }
+        }
+
+        std::println("SlotMap - dense array ...");
+        {
+            GenerationalSlotMap::SlotMap<Particle> particles;
+            std::vector<GenerationalSlotMap::Handle> entities;
+            std::mt19937 generator{ 42 };
+
+            auto erase = [&] (auto handle) { particles.erase(handle); };
+            auto create = [&] () { return particles.emplace(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f); };
+
+            particles.reserve(Entities);
+            for (std::size_t i{}; i != Entities; ++i) {
+                entities.push_back(create());
+            }
+
+            for (std::size_t tick{}; tick != Ticks; ++tick) {
+                churn(entities, generator, erase, create);
+            }
+
+            std::println("Update:");
+            {
+                ScopedTimer watch{};
+
+                for (std::size_t tick{}; tick != Ticks; ++tick) {
+                    for (auto& particle : particles) {
+                        update(particle);
+                    }
+                }
+            }
+
+            std::println("Erase / create:");
+            {
+                ScopedTimer watch{};
+
+                for (std::size_t tick{}; tick != Ticks; ++tick) {
+                    churn(entities, generator, erase, create);
+                }
+            }
+        }
+    }
+    // inserting without reserve(): the arrays must grow geometrically -
+    // twice the number of objects takes about twice the time
+    static void main_slot_map_21()
+    {
+        for (std::size_t count{ Entities / 4 }; count <= 4 * Entities; count *= 2) {
+
+            std::println("{} inserts without reserve:", count);
+
+            ScopedTimer watch{};
+
+            GenerationalSlotMap::SlotMap<Particle> particles;
+            for (std::size_t i{}; i != count; ++i) {
+                particles.emplace(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+            }
+        }
+    }
+}
+
+void main_slot_map()
+{
+    SlotMap_SimpleTest::main_slot_map_01();
+    SlotMap_SimpleTest::main_slot_map_02();
+    SlotMap_SimpleTest::main_slot_map_03();
+
+    SlotMap_Benchmark::main_slot_map_20();
+    SlotMap_Benchmark::main_slot_map_21();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,378 @@
+// ===========================================================================
+// StringFlatMap.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STRING_FLAT_MAP_SSE2
+#endif
+
+namespace StringFlatMapping {
+
+    // Open addressing hash map with string keys, specialized for short keys (words):
+    //
+    //  * Flat storage: one array of slots, no node per element, no pointer chasing.
+    //
+    //  * One control byte per slot: 'Empty' or the lowest 7 bits of the hash of the key.
+    //    A probe compares a group of 16 control bytes with a single SSE2 comparison,
+    //    a key is compared only, if its 7 hash bits match (1 : 128 for a wrong key).
+    //
+    //  * Keys up to 'InlineCapacity' characters are stored inline in the slot,
+    //    longer keys in an arena (monotonic, from the memory resource of the map).
+    //
+    //  * Lookup by std::string_view - no temporary std::string, no allocation.
+    //
+    //  * All memory comes from a std::pmr::memory_resource.
+    //
+    // Elements are never erased (like in a histogram): no tombstones are needed.
+    // References to values are invalidated by an insertion, which grows the table.
+
+    template <typename TValue, typename THash = std::hash<std::string_view>>
+    class StringFlatMap
+    {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        static constexpr std::size_t InlineCapacity{ 16 };
+
+    private:
+        static constexpr std::size_t GroupWidth{ 16 };
+        static constexpr std::size_t MinCapacity{ 16 };
+
+        static constexpr std::int8_t Empty{ -128 };
+
+        struct Key
+        {
+            std::size_t m_length;
+
+            union {
+                char        m_inline[InlineCapacity];
+                const char* m_external;
+            };
+
+            std::string_view view() const {
+                return { (m_length <= InlineCapacity) ? m_inline : m_external, m_length };
+            }
+        };
+
+        struct Slot
+        {
+            Key     m_key;
+            TValue  m_value;
+        };
+
+    public:
+        // c'tor/d'tor
+        explicit StringFlatMap(const allocator_type& alloc = {})
+            : m_alloc{ alloc }, m_keys{ alloc.resource() },
+              m_slots{}, m_control{ nullptr }, m_mask{}, m_size{}, m_growthLeft{}
+        {
+        }
+
+        ~StringFlatMap() {
+            release();
+        }
+
+        // no copy, no move (the arena of the keys is not movable)
+        StringFlatMap(const StringFlatMap&) = delete;
+        StringFlatMap& operator=(const StringFlatMap&) = delete;
+        StringFlatMap(StringFlatMap&&) = delete;
+        StringFlatMap& operator=(StringFlatMap&&) = delete;
+
+        // getter
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        std::size_t capacity() const { return (m_control == nullptr) ? 0 : m_mask + 1; }
+        allocator_type get_allocator() const { return m_alloc; }
+
+        // lookup
+        TValue* find(std::string_view key) {
+            return const_cast<TValue*>(std::as_const(*this).find(key));
+        }
+
+        const TValue* find(std::string_view key) const {
+
+            if (m_size == 0) {
+                return nullptr;
+            }
+
+            const std::size_t hash{ THash{}(key) };
+            const std::size_t index{ lookup(key, hash) };
+
+            return (index == NotFound) ? nullptr : &m_slots[index].m_value;
+        }
+
+        bool contains(std::string_view key) const {
+            return find(key) != nullptr;
+        }
+
+        // lookup-or-insert - a new value is value-initialized
+        TValue& operator[](std::string_view key) {
+
+            const std::size_t hash{ THash{}(key) };
+
+            if (m_size != 0) {
+                if (std::size_t index{ lookup(key, hash) }; index != NotFound) {
+                    return m_slots[index].m_value;
+                }
+            }
+
+            if (m_growthLeft == 0) {
+                rehash(capacity() == 0 ? MinCapacity : 2 * capacity());
+            }
+
+            const std::size_t index{ findEmpty(hash) };
+
+            Slot* slot{ ::new (static_cast<void*>(&m_slots[index])) Slot{} };
+            storeKey(slot->m_key, key);
+            setControl(index, h2(hash));
+
+            ++m_size;
+            --m_growthLeft;
+
+            return slot->m_value;
+        }
+
+        // capacity for 'count' elements without growing
+        void reserve(std::size_t count) {
+
+            std::size_t required{ MinCapacity };
+            while (maxLoad(required) < count) {
+                required *= 2;
+            }
+
+            if (required > capacity()) {
+                rehash(required);
+            }
+        }
+
+        // iteration: pairs of key (std::string_view) and reference to the value
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using Map = std::conditional_t<IsConst, const StringFlatMap, StringFlatMap>;
+            using Value = std::conditional_t<IsConst, const TValue, TValue>;
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<std::string_view, Value&>;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            Iterator(Map* map, std::size_t index) : m_map{ map }, m_index{ index } {
+                skipEmpty();
+            }
+
+            value_type operator*() const {
+                auto& slot{ m_map->m_slots[m_index] };
+                return { slot.m_key.view(), slot.m_value };
+            }
+
+            Iterator& operator++() {
+                ++m_index;
+                skipEmpty();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator tmp{ *this };
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const Iterator&, const Iterator&) = default;
+
+        private:
+            void skipEmpty() {
+                while (m_index < m_map->capacity() && m_map->m_control[m_index] == Empty) {
+                    ++m_index;
+                }
+            }
+
+            Map*         m_map{ nullptr };
+            std::size_t  m_index{};
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        iterator begin() { return { this, 0 }; }
+        iterator end() { return { this, capacity() }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, capacity() }; }
+
+    private:
+        static constexpr std::size_t NotFound{ static_cast<std::size_t>(-1) };
+
+        // the upper bits select the group, the lower 7 bits are stored in the control byte
+        static std::size_t h1(std::size_t hash) { return hash >> 7; }
+        static std::int8_t h2(std::size_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+
+        // load factor 7/8
+        static std::size_t maxLoad(std::size_t capacity) { return capacity - capacity / 8; }
+
+        // bit i: control byte 'pos + i' equals 'value'
+        std::uint32_t matchGroup(std::size_t pos, std::int8_t value) const {
+#if defined(STRING_FLAT_MAP_SSE2)
+            const __m128i group{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_control + pos)) };
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value))));
+#else
+            std::uint32_t mask{};
+            for (std::size_t i{}; i != GroupWidth; ++i) {
+                mask |= std::uint32_t{ m_control[pos + i] == value } << i;
+            }
+            return mask;
+#endif
+        }
+
+        // quadratic probing in steps of whole groups - visits every group once
+        std::size_t lookup(std::string_view key, std::size_t hash) const {
+
+            const std::int8_t tag{ h2(hash) };
+
+            std::size_t pos{ h1(hash) & m_mask };
+
+            for (std::size_t step{ GroupWidth }; ; step += GroupWidth) {
+
+                for (std::uint32_t match{ matchGroup(pos, tag) }; match != 0; match &= match - 1) {
+
+                    const std::size_t index{ (pos + std::countr_zero(match)) & m_mask };
+                    const Key& candidate{ m_slots[index].m_key };
+
+                    if (candidate.m_length == key.size() && std::memcmp(candidate.view().data(), key.data(), key.size()) == 0) {
+                        return index;
+                    }
+                }
+
+                // an empty slot ends the probe sequence
+                if (matchGroup(pos, Empty) != 0) {
+                    return NotFound;
+                }
+
+                pos = (pos + step) & m_mask;
+            }
+        }
+
+        std::size_t findEmpty(std::size_t hash) const {
+
+            std::size_t pos{ h1(hash) & m_mask };
+
+            for (std::size_t step{ GroupWidth }; ; step += GroupWidth) {
+
+                if (std::uint32_t empty{ matchGroup(pos, Empty) }; empty != 0) {
+                    return (pos + std::countr_zero(empty)) & m_mask;
+                }
+
+                pos = (pos + step) & m_mask;
+            }
+        }
+
+        // the first 'GroupWidth' control bytes are mirrored behind the last one:
+        // a group can be loaded at every position without a wrap-around
+        void setControl(std::size_t index, std::int8_t value) {
+            m_control[index] = value;
+            if (index < GroupWidth) {
+                m_control[m_mask + 1 + index] = value;
+            }
+        }
+
+        void storeKey(Key& key, std::string_view sv) {
+
+            key.m_length = sv.size();
+
+            if (sv.size() <= InlineCapacity) {
+                std::memcpy(key.m_inline, sv.data(), sv.size());
+            }
+            else {
+                char* chars{ static_cast<char*>(m_keys.allocate(sv.size(), 1)) };
+                std::memcpy(chars, sv.data(), sv.size());
+                key.m_external = chars;
+            }
+        }
+
+        static std::size_t bytesFor(std::size_t capacity) {
+            return capacity * sizeof(Slot) + capacity + GroupWidth;
+        }
+
+        void rehash(std::size_t newCapacity) {
+
+            Slot* oldSlots{ m_slots };
+            std::int8_t* oldControl{ m_control };
+            const std::size_t oldCapacity{ capacity() };
+
+            // slots and control bytes in one allocation
+            void* memory{ m_alloc.allocate_bytes(bytesFor(newCapacity), alignof(Slot)) };
+
+            m_slots = static_cast<Slot*>(memory);
+            m_control = reinterpret_cast<std::int8_t*>(m_slots + newCapacity);
+            m_mask = newCapacity - 1;
+            m_growthLeft = maxLoad(newCapacity) - m_size;
+
+            std::memset(m_control, Empty, newCapacity + GroupWidth);
+
+            // the keys stay where they are: a long key points into the arena
+            for (std::size_t i{}; i != oldCapacity; ++i) {
+
+                if (oldControl[i] != Empty) {
+
+                    Slot& slot{ oldSlots[i] };
+
+                    const std::size_t hash{ THash{}(slot.m_key.view()) };
+                    const std::size_t index{ findEmpty(hash) };
+
+                    ::new (static_cast<void*>(&m_slots[index])) Slot{ std::move(slot) };
+                    setControl(index, h2(hash));
+
+                    slot.~Slot();
+                }
+            }
+
+            if (oldControl != nullptr) {
+                m_alloc.deallocate_bytes(oldSlots, bytesFor(oldCapacity), alignof(Slot));
+            }
+        }
+
+        void release() {
+
+            if (m_control == nullptr) {
+                return;
+            }
+
+            for (std::size_t i{}; i != capacity(); ++i) {
+                if (m_control[i] != Empty) {
+                    m_slots[i].~Slot();
+                }
+            }
+
+            m_alloc.deallocate_bytes(m_slots, bytesFor(capacity()), alignof(Slot));
+        }
+
+        // member data
+        allocator_type                        m_alloc;
+        std::pmr::monotonic_buffer_resource   m_keys;         // arena of the long keys
+        Slot*                                 m_slots;
+        std::int8_t*                          m_control;
+        std::size_t                           m_mask;
+        std::size_t                           m_size;
+        std::size_t                           m_growthLeft;
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,220 @@
+// ===========================================================================
+// StringFlatMap_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "StringFlatMap.h"
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <print>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace StringFlatMap_SimpleTest {
+
+    using namespace StringFlatMapping;
+
+    static void main_string_flat_map_01()
+    {
+        StringFlatMap<std::size_t> map;
+
+        std::string_view text{ "to be or not to be that is the question whether tis nobler in the mind to suffer" };
+
+        std::size_t begin{};
+        while (begin < text.size()) {
+            std::size_t end{ text.find(' ', begin) };
+            if (end == std::string_view::npos) {
+                end = text.size();
+            }
+            ++map[text.substr(begin, end - begin)];
+            begin = end + 1;
+        }
+
+        // a long key is stored in the arena
+        map["a-key-longer-than-the-inline-capacity"] = 42;
+
+        std::println("size: {} - capacity: {}", map.size(), map.capacity());
+
+        for (const auto& [word, count] : map) {
+            std::print("{}:{} ", word, count);
+        }
+        std::println();
+
+        const std::size_t* pos{ map.find("be") };
+        std::println("find(\"be\"): {} - contains(\"hamlet\"): {}", (pos != nullptr) ? *pos : 0, map.contains("hamlet"));
+    }
+
+    // growing through many rehashes - compared with std::unordered_map
+    static void main_string_flat_map_02()
+    {
+        StringFlatMap<std::size_t> map;
+        std::unordered_map<std::string, std::size_t> reference;
+
+        for (std::size_t i{}; i != 100'000; ++i) {
+            const std::string key{ "key_" + std::to_string(i % 30'011) + ((i % 3 == 0) ? "_with_a_long_suffix" : "") };
+            ++map[key];
+            ++reference[key];
+        }
+
+        bool ok{ map.size() == reference.size() };
+
+        for (const auto& [key, count] : reference) {
+            const std::size_t* pos{ map.find(key) };
+            ok = ok && pos != nullptr && *pos == count;
+        }
+
+        std::println("size: {} - capacity: {} - same contents as std::unordered_map: {}", map.size(), map.capacity(), ok);
+    }
+}
+
+namespace StringFlatMap_Benchmark {
+
+    using namespace StringFlatMapping;
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 1;         // debug
+#else
+    static constexpr int Rounds = 10;        // release
+#endif
+
+    // the words of the file as views into its contents
+    static std::vector<std::string_view> splitWords(const std::string& text)
+    {
+        std::vector<std::string_view> words;
+
+        auto isLetter = [] (char ch) {
+            return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+        };
+
+        std::size_t pos{};
+        while (pos != text.size()) {
+            while (pos != text.size() && !isLetter(text[pos]))
+                ++pos;
+            const std::size_t begin{ pos };
+            while (pos != text.size() && isLetter(text[pos]))
+                ++pos;
+            if (pos != begin) {
+                words.emplace_back(text.data() + begin, pos - begin);
+            }
+        }
+
+        return words;
+    }
+
+    // heterogeneous lookup for std::unordered_map (C++20)
+    struct TransparentHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view sv) const noexcept {
+            return std::hash<std::string_view>{}(sv);
+        }
+    };
+
+    static void main_string_flat_map_20()
+    {
+        std::ifstream file{ "LoremIpsumHuge.txt", std::ios::binary };
+        const std::string text{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+        const std::vector<std::string_view> words{ splitWords(text) };
+
+        std::println("{} words, {} rounds", words.size(), Rounds);
+
+        std::size_t unique{};
+
+        std::println("std::unordered_map<std::string> - temporary std::string per word:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+                std::unordered_map<std::string, std::size_t> map;
+                for (std::string_view word : words) {
+                    std::string s{ word };
+                    ++map[s];
+                }
+                unique += map.size();
+            }
+        }
+
+        std::println("std::unordered_map<std::string> - heterogeneous lookup:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+                std::unordered_map<std::string, std::size_t, TransparentHash, std::equal_to<>> map;
+                for (std::string_view word : words) {
+                    if (auto pos{ map.find(word) }; pos != map.end()) {
+                        ++pos->second;
+                    }
+                    else {
+                        map.emplace(word, 1);
+                    }
+                }
+                unique += map.size();
+            }
+        }
+
+        std::println("std::pmr::unordered_map<std::pmr::string> - pool resource:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+                std::pmr::unsynchronized_pool_resource pool;
+                std::pmr::unordered_map<std::pmr::string, std::size_t> map{ &pool };
+                for (std::string_view word : words) {
+                    std::pmr::string s{ word, &pool };
+                    ++map[s];
+                }
+                unique += map.size();
+            }
+        }
+
+        std::println("StringFlatMap:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+                StringFlatMap<std::size_t> map;
+                for (std::string_view word : words) {
+                    ++map[word];
+                }
+                unique += map.size();
+            }
+        }
+
+        std::println("StringFlatMap - monotonic buffer resource:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+                std::pmr::monotonic_buffer_resource arena;
+                StringFlatMap<std::size_t> map{ &arena };
+                for (std::string_view word : words) {
+                    ++map[word];
+                }
+                unique += map.size();
+            }
+        }
+
+        std::println("Unique words: {}", unique / (5 * Rounds));
+    }
+}
+
+void main_string_flat_map()
+{
+    StringFlatMap_SimpleTest::main_string_flat_map_01();
+    StringFlatMap_SimpleTest::main_string_flat_map_02();
+
+    StringFlatMap_Benchmark::main_string_flat_map_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,145 @@
+// ===========================================================================
+// StringInterner.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace StringInterning {
+
+    // Symbol: 32-bit id of an interned string.
+    // Two symbols of the same interner are equal, if and only if their strings are equal.
+    // The default constructed symbol is the null symbol - no string has this id.
+    struct Symbol
+    {
+        std::uint32_t m_id{ 0 };
+
+        bool isNull() const { return m_id == 0; }
+
+        friend bool operator==(const Symbol&, const Symbol&) = default;
+    };
+
+    // String interning table:
+    //
+    //  * Each unique string is stored once, immutable and '\0'-terminated,
+    //    in an arena of large chunks - it never moves, views stay valid for
+    //    the lifetime of the interner.
+    //
+    //  * Entries (string and cached hash) are indexed by the symbol id.
+    //    They live in segments of doubling size, which are never moved:
+    //    'view' and 'hash' don't need a lock.
+    //
+    //  * The hash index is split into shards, each one an open addressing table.
+    //    Lookups don't take a lock: slots are written once (atomically, after the entry),
+    //    a table, that is replaced when growing, is kept until the interner is destroyed
+    //    (together all of them take less memory than the current one).
+    //    Only the insertion of a new string takes the lock of its shard.
+
+    class StringInterner
+    {
+    private:
+        struct Entry
+        {
+            const char*    m_chars;
+            std::size_t    m_length;
+            std::size_t    m_hash;
+        };
+
+        // slot: id in the lower 32 bits (0: empty), lower 32 bits of the hash in the upper 32 bits
+        struct Table
+        {
+            std::size_t                                   m_mask;
+            std::unique_ptr<std::atomic<std::uint64_t>[]> m_slots;
+        };
+
+        struct Shard
+        {
+            std::mutex                           m_mutex;      // writers only
+            std::atomic<Table*>                  m_table{ nullptr };
+            std::vector<std::unique_ptr<Table>>  m_tables;     // current and replaced tables
+            std::size_t                          m_size{};
+
+            // arena
+            std::vector<std::unique_ptr<char[]>> m_chunks;
+            char*                                m_next{ nullptr };
+            std::size_t                          m_remaining{};
+        };
+
+        static constexpr std::size_t ShardBits{ 4 };
+        static constexpr std::size_t NumShards{ std::size_t{ 1 } << ShardBits };
+        static constexpr std::size_t InitialSlots{ 64 };
+        static constexpr std::size_t ChunkSize{ 64 * 1024 };
+
+        static constexpr std::size_t FirstSegmentBits{ 10 };
+        static constexpr std::size_t NumSegments{ 32 - FirstSegmentBits + 1 };
+
+    public:
+        // c'tor/d'tor
+        StringInterner();
+        ~StringInterner();
+
+        // no copy, no move (symbols and views refer to the interner)
+        StringInterner(const StringInterner&) = delete;
+        StringInterner& operator=(const StringInterner&) = delete;
+        StringInterner(StringInterner&&) = delete;
+        StringInterner& operator=(StringInterner&&) = delete;
+
+        // lookup-or-insert - thread-safe
+        Symbol intern(std::string_view sv);
+
+        // lookup only - the null symbol, if 'sv' isn't interned
+        Symbol find(std::string_view sv) const;
+
+        // the symbol must originate from this interner
+        std::string_view view(Symbol symbol) const;
+        const char* c_str(Symbol symbol) const;
+        std::size_t hash(Symbol symbol) const;
+
+        std::size_t size() const;
+
+        // process-wide interner
+        static StringInterner& global();
+
+    private:
+        Symbol lookup(const Table& table, std::string_view sv, std::size_t hash) const;
+        Symbol insert(Shard& shard, std::string_view sv, std::size_t hash);
+        const char* store(Shard& shard, std::string_view sv);
+        void grow(Shard& shard);
+
+        const Entry& entry(std::uint32_t id) const;
+        Entry& createEntry(std::uint32_t id);
+
+        static std::size_t shardOf(std::size_t hash) { return hash & (NumShards - 1); }
+        static std::unique_ptr<Table> makeTable(std::size_t size);
+
+        // member data
+        std::array<Shard, NumShards>                    m_shards;
+        std::array<std::atomic<Entry*>, NumSegments>    m_segments;
+        std::atomic<std::uint32_t>                      m_nextId;
+    };
+}
+
+namespace std
+{
+    // symbols are unique - the id is a perfect hash
+    template <>
+    struct hash<StringInterning::Symbol>
+    {
+        std::size_t operator() (const StringInterning::Symbol& symbol) const noexcept {
+            return symbol.m_id;
+        }
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,260 @@
+// ===========================================================================
+// StringInternerImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "StringInterner.h"
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace StringInterning {
+
+    // =======================================================================
+    // c'tor/d'tor
+
+    StringInterner::StringInterner()
+        : m_segments{}, m_nextId{ 1 }    // id 0 is the null symbol
+    {
+        for (auto& shard : m_shards) {
+            shard.m_tables.push_back(makeTable(InitialSlots));
+            shard.m_table.store(shard.m_tables.back().get(), std::memory_order_relaxed);
+        }
+    }
+
+    StringInterner::~StringInterner()
+    {
+        for (auto& segment : m_segments) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    StringInterner& StringInterner::global()
+    {
+        static StringInterner interner{};
+        return interner;
+    }
+
+    // =======================================================================
+    // public interface
+
+    Symbol StringInterner::intern(std::string_view sv)
+    {
+        const std::size_t hash{ std::hash<std::string_view>{}(sv) };
+        Shard& shard{ m_shards[shardOf(hash)] };
+
+        // fast path: the string is known already - no lock
+        if (Symbol symbol{ lookup(*shard.m_table.load(std::memory_order_acquire), sv, hash) }; !symbol.isNull()) {
+            return symbol;
+        }
+
+        std::lock_guard<std::mutex> guard{ shard.m_mutex };
+
+        // another thread may have inserted the string in the meantime
+        if (Symbol symbol{ lookup(*shard.m_table.load(std::memory_order_relaxed), sv, hash) }; !symbol.isNull()) {
+            return symbol;
+        }
+
+        return insert(shard, sv, hash);
+    }
+
+    Symbol StringInterner::find(std::string_view sv) const
+    {
+        const std::size_t hash{ std::hash<std::string_view>{}(sv) };
+        const Shard& shard{ m_shards[shardOf(hash)] };
+
+        return lookup(*shard.m_table.load(std::memory_order_acquire), sv, hash);
+    }
+
+    std::string_view StringInterner::view(Symbol symbol) const
+    {
+        const Entry& e{ entry(symbol.m_id) };
+        return { e.m_chars, e.m_length };
+    }
+
+    const char* StringInterner::c_str(Symbol symbol) const
+    {
+        return entry(symbol.m_id).m_chars;
+    }
+
+    std::size_t StringInterner::hash(Symbol symbol) const
+    {
+        return entry(symbol.m_id).m_hash;
+    }
+
+    std::size_t StringInterner::size() const
+    {
+        return m_nextId.load(std::memory_order_relaxed) - 1;
+    }
+
+    // =======================================================================
+    // hash index
+
+    // Lock-free: intern() and find() call it without the lock of the shard.
+    // The table itself was published by the release store of Shard::m_table in grow(),
+    // which the caller's acquire load of m_table synchronizes with.
+    // An entry (chars, length, hash) is written before insert() publishes its id with the
+    // release store of the slot - the acquire load of the slot below makes it visible.
+    Symbol StringInterner::lookup(const Table& table, std::string_view sv, std::size_t hash) const
+    {
+        const auto tag{ static_cast<std::uint32_t>(hash) };
+
+        // linear probing - the lowest bits select the shard, the bits above the slot
+        for (std::size_t index{ (hash >> ShardBits) & table.m_mask }; ; index = (index + 1) & table.m_mask) {
+
+            const std::uint64_t slot{ table.m_slots[index].load(std::memory_order_acquire) };
+            const auto id{ static_cast<std::uint32_t>(slot) };
+
+            if (id == 0) {
+                return Symbol{};
+            }
+
+            if (static_cast<std::uint32_t>(slot >> 32) == tag) {
+                const Entry& e{ entry(id) };
+                if (e.m_length == sv.size() && std::memcmp(e.m_chars, sv.data(), sv.size()) == 0) {
+                    return Symbol{ id };
+                }
+            }
+        }
+    }
+
+    // the caller holds the lock of the shard
+    Symbol StringInterner::insert(Shard& shard, std::string_view sv, std::size_t hash)
+    {
+        // keep the load factor below 3/4
+        if ((shard.m_size + 1) * 4 > (shard.m_table.load(std::memory_order_relaxed)->m_mask + 1) * 3) {
+            grow(shard);
+        }
+
+        const std::uint32_t id{ m_nextId.fetch_add(1, std::memory_order_relaxed) };
+        if (id == std::numeric_limits<std::uint32_t>::max()) {
+            throw std::bad_alloc{};
+        }
+
+        Entry& e{ createEntry(id) };
+        e.m_chars = store(shard, sv);
+        e.m_length = sv.size();
+        e.m_hash = hash;
+
+        Table& table{ *shard.m_table.load(std::memory_order_relaxed) };
+
+        std::size_t index{ (hash >> ShardBits) & table.m_mask };
+        while (table.m_slots[index].load(std::memory_order_relaxed) != 0) {
+            index = (index + 1) & table.m_mask;
+        }
+
+        // publish the entry
+        table.m_slots[index].store((std::uint64_t{ static_cast<std::uint32_t>(hash) } << 32) | id, std::memory_order_release);
+        ++shard.m_size;
+
+        return Symbol{ id };
+    }
+
+    // the caller holds the lock of the shard
+    void StringInterner::grow(Shard& shard)
+    {
+        const Table& current{ *shard.m_table.load(std::memory_order_relaxed) };
+
+        std::unique_ptr<Table> table{ makeTable(2 * (current.m_mask + 1)) };
+
+        // rehashing needs no string: the full hash is cached in the entry
+        for (std::size_t i{}; i != current.m_mask + 1; ++i) {
+
+            const std::uint64_t slot{ current.m_slots[i].load(std::memory_order_relaxed) };
+
+            if (slot != 0) {
+
+                std::size_t index{ (entry(static_cast<std::uint32_t>(slot)).m_hash >> ShardBits) & table->m_mask };
+                while (table->m_slots[index].load(std::memory_order_relaxed) != 0) {
+                    index = (index + 1) & table->m_mask;
+                }
+
+                table->m_slots[index].store(slot, std::memory_order_relaxed);
+            }
+        }
+
+        // readers still using the replaced table find all strings but the ones inserted from now on
+        shard.m_tables.push_back(std::move(table));
+        shard.m_table.store(shard.m_tables.back().get(), std::memory_order_release);
+    }
+
+    std::unique_ptr<StringInterner::Table> StringInterner::makeTable(std::size_t size)
+    {
+        auto table{ std::make_unique<Table>(Table{ size - 1, std::make_unique<std::atomic<std::uint64_t>[]>(size) }) };
+        return table;
+    }
+
+    // =======================================================================
+    // arena: strings are stored back to back, '\0'-terminated
+
+    const char* StringInterner::store(Shard& shard, std::string_view sv)
+    {
+        const std::size_t needed{ sv.size() + 1 };
+
+        if (needed > shard.m_remaining) {
+
+            // a long string gets a chunk of its own, the current chunk stays in use
+            if (needed > ChunkSize / 4) {
+                shard.m_chunks.push_back(std::make_unique_for_overwrite<char[]>(needed));
+                char* chars{ shard.m_chunks.back().get() };
+                std::memcpy(chars, sv.data(), sv.size());
+                chars[sv.size()] = '\0';
+                return chars;
+            }
+
+            shard.m_chunks.push_back(std::make_unique_for_overwrite<char[]>(ChunkSize));
+            shard.m_next = shard.m_chunks.back().get();
+            shard.m_remaining = ChunkSize;
+        }
+
+        char* chars{ shard.m_next };
+        std::memcpy(chars, sv.data(), sv.size());
+        chars[sv.size()] = '\0';
+
+        shard.m_next += needed;
+        shard.m_remaining -= needed;
+
+        return chars;
+    }
+
+    // =======================================================================
+    // entries: segment 0 holds 2^FirstSegmentBits entries, each further segment twice as many
+
+    const StringInterner::Entry& StringInterner::entry(std::uint32_t id) const
+    {
+        const std::uint64_t position{ std::uint64_t{ id } + (std::uint64_t{ 1 } << FirstSegmentBits) };
+        const auto bits{ static_cast<std::size_t>(std::bit_width(position)) - 1 };
+
+        const Entry* segment{ m_segments[bits - FirstSegmentBits].load(std::memory_order_acquire) };
+        return segment[position - (std::uint64_t{ 1 } << bits)];
+    }
+
+    StringInterner::Entry& StringInterner::createEntry(std::uint32_t id)
+    {
+        const std::uint64_t position{ std::uint64_t{ id } + (std::uint64_t{ 1 } << FirstSegmentBits) };
+        const auto bits{ static_cast<std::size_t>(std::bit_width(position)) - 1 };
+
+        std::atomic<Entry*>& slot{ m_segments[bits - FirstSegmentBits] };
+        Entry* segment{ slot.load(std::memory_order_acquire) };
+
+        // the segment may be created concurrently by inserts into other shards
+        if (segment == nullptr) {
+
+            Entry* created{ new Entry[std::size_t{ 1 } << bits]{} };
+
+            if (slot.compare_exchange_strong(segment, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                segment = created;
+            }
+            else {
+                delete[] created;
+            }
+        }
+
+        return segment[position - (std::uint64_t{ 1 } << bits)];
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
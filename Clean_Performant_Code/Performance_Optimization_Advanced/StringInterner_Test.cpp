@@ -0,0 +1,206 @@
+// ===========================================================================
+// StringInterner_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "StringInterner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace StringInterner_SimpleTest {
+
+    using namespace StringInterning;
+
+    static void main_string_interner_01()
+    {
+        StringInterner interner;
+
+        Symbol hello{ interner.intern("Hello") };
+        Symbol world{ interner.intern("World") };
+
+        std::string text{ "Hello" };
+        Symbol again{ interner.intern(text) };   // known string: same symbol, no allocation
+
+        std::println("{} => id {} - hash {}", interner.view(hello), hello.m_id, interner.hash(hello));
+        std::println("{} => id {} - hash {}", interner.view(world), world.m_id, interner.hash(world));
+        std::println("hello == again: {} - hello == world: {}", hello == again, hello == world);
+        std::println("find(\"Universe\") is null: {}", interner.find("Universe").isNull());
+        std::println("Size: {}", interner.size());
+    }
+
+    // all threads intern the same strings: all of them get the same symbols
+    static void main_string_interner_02()
+    {
+        static constexpr int NumThreads = 4;
+        static constexpr int NumStrings = 10'000;
+
+        StringInterner interner;
+
+        std::vector<std::vector<Symbol>> symbols(NumThreads);
+        std::vector<std::thread> threads;
+
+        for (int i{}; i != NumThreads; ++i) {
+            threads.emplace_back([&, i] () {
+                for (int n{}; n != NumStrings; ++n) {
+                    symbols[i].push_back(interner.intern("string_" + std::to_string(n)));
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        bool equal{ std::all_of(symbols.begin(), symbols.end(), [&] (const auto& s) { return s == symbols[0]; }) };
+
+        std::println("{} threads, {} strings: size {} - same symbols in all threads: {}", NumThreads, NumStrings, interner.size(), equal);
+    }
+}
+
+namespace StringInterner_Benchmark {
+
+    using namespace StringInterning;
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 1;         // debug
+#else
+    static constexpr int Rounds = 10;        // release
+#endif
+
+    // the words of the file - tokenized like in TextfileStatistics
+    static std::vector<std::string> readWords(std::string_view fileName)
+    {
+        std::vector<std::string> words;
+
+        std::ifstream file{ fileName.data() };
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::string_view sv{ line };
+
+            std::size_t begin{};
+            std::size_t end{};
+
+            while (end != sv.size()) {
+
+                while (end != sv.size() && std::isalpha(sv[end]))
+                    ++end;
+
+                std::string s{ sv.substr(begin, end - begin) };
+                if (!s.empty() && std::isupper(s[0])) {
+                    s[0] = static_cast<char>(std::tolower(s[0]));
+                }
+
+                words.push_back(std::move(s));
+
+                while (end != sv.size() && (sv[end] == ' ' || sv[end] == '.' || sv[end] == ','))
+                    ++end;
+
+                begin = end;
+            }
+        }
+
+        return words;
+    }
+
+    static void main_string_interner_20()
+    {
+        const std::vector<std::string> words{ readWords("LoremIpsumHuge.txt") };
+
+        std::println("Counting {} words, {} times", words.size(), Rounds);
+
+        std::println("std::unordered_map<std::string, std::size_t>:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+
+                std::unordered_map<std::string, std::size_t> frequencies;
+
+                for (const auto& word : words) {
+                    ++frequencies[word];
+                }
+            }
+        }
+
+        StringInterner interner;
+
+        std::println("intern + std::unordered_map<Symbol, std::size_t>:");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+
+                std::unordered_map<Symbol, std::size_t> frequencies;
+
+                for (const auto& word : words) {
+                    ++frequencies[interner.intern(word)];
+                }
+            }
+        }
+
+        // the ids are dense - a vector is the perfect map
+        std::println("intern + std::vector<std::size_t> (indexed by id):");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+
+                std::vector<std::size_t> frequencies;
+
+                for (const auto& word : words) {
+                    Symbol symbol{ interner.intern(word) };
+                    if (symbol.m_id >= frequencies.size()) {
+                        frequencies.resize(symbol.m_id + 1);
+                    }
+                    ++frequencies[symbol.m_id];
+                }
+            }
+        }
+
+        // once interned, the symbols are the keys: hashing and comparing integers only
+        std::vector<Symbol> symbols;
+        for (const auto& word : words) {
+            symbols.push_back(interner.intern(word));
+        }
+
+        std::println("std::unordered_map<Symbol, std::size_t> (symbols interned in advance):");
+        {
+            ScopedTimer watch{};
+
+            for (int round{}; round != Rounds; ++round) {
+
+                std::unordered_map<Symbol, std::size_t> frequencies;
+
+                for (Symbol symbol : symbols) {
+                    ++frequencies[symbol];
+                }
+            }
+        }
+
+        std::println("Unique words: {}", interner.size());
+    }
+}
+
+void main_string_interner()
+{
+    StringInterner_SimpleTest::main_string_interner_01();
+    StringInterner_SimpleTest::main_string_interner_02();
+
+    StringInterner_Benchmark::main_string_interner_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
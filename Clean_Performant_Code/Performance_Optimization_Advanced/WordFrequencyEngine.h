@@ -0,0 +1,84 @@
+// ===========================================================================
+// WordFrequencyEngine.h // Performance Optimization Advanced
+// ===========================================================================
+
+#pragma once
+
+#include "MemoryMappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace WordFrequency {
+
+    // Words are maximal runs of ASCII letters, everything else separates them.
+    // Like in TextfileStatistics, an uppercase first letter is folded to lowercase:
+    // "Lorem" and "lorem" are the same word.
+
+    // hash and equality of words - with the first letter folded to lowercase
+    struct WordHash
+    {
+        std::size_t operator()(std::string_view word) const noexcept;
+    };
+
+    struct WordEqual
+    {
+        bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+    };
+
+    // the keys are views into the mapped file - no copy of any word
+    using WordMap = std::unordered_map<std::string_view, std::size_t, WordHash, WordEqual>;
+
+    struct WordCount
+    {
+        std::string  m_word;        // first letter folded to lowercase
+        std::size_t  m_count;
+    };
+
+    // Parallel word frequency engine:
+    //
+    //  1. the file is mapped into memory (no read, no copy of lines)
+    //  2. the mapping is split into one chunk per thread, the chunk boundaries
+    //     are moved to the end of the word, so that no word is split
+    //  3. each thread tokenizes its chunk into a map of its own (no locking, no sharing)
+    //  4. the maps are merged pairwise, in parallel (a tree of merges)
+    //  5. the top-K words are selected with a partial sort
+
+    class Engine
+    {
+    public:
+        // c'tor
+        explicit Engine(std::string_view fileName);
+
+        // public interface
+        void count(std::size_t numThreads = 0);     // 0: one thread per core
+
+        std::vector<WordCount> topWords(std::size_t k) const;
+
+        // getter
+        std::size_t totalWords() const { return m_totalWords; }
+        std::size_t uniqueWords() const { return m_frequencies.size(); }
+        std::size_t fileSize() const { return m_file.size(); }
+
+        const WordMap& frequencies() const { return m_frequencies; }
+
+        // tokenizes 'text' into 'map' - returns the number of words
+        static std::size_t countWords(std::string_view text, WordMap& map);
+
+        // split positions of 'text' into 'numChunks' chunks - no word is split
+        static std::vector<std::size_t> split(std::string_view text, std::size_t numChunks);
+
+    private:
+        MemoryMappedFile  m_file;
+        WordMap           m_frequencies;
+        std::size_t       m_totalWords;
+    };
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
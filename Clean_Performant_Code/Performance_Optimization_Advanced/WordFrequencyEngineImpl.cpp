@@ -0,0 +1,199 @@
+// ===========================================================================
+// WordFrequencyEngineImpl.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "WordFrequencyEngine.h"
+#include "SimdTokenizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace WordFrequency {
+
+    // =======================================================================
+    // character classification - a table instead of the locale dependent std::isalpha
+
+    static constexpr std::array<bool, 256> LetterTable = [] () {
+        std::array<bool, 256> table{};
+        for (int ch{ 'a' }; ch <= 'z'; ++ch) {
+            table[ch] = true;
+            table[ch - 'a' + 'A'] = true;
+        }
+        return table;
+    } ();
+
+    static bool isLetter(char ch)
+    {
+        return LetterTable[static_cast<unsigned char>(ch)];
+    }
+
+    static char foldFirst(char ch)
+    {
+        return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+    }
+
+    // =======================================================================
+    // hash and equality: FNV-1a, the first letter folded to lowercase
+
+    std::size_t WordHash::operator()(std::string_view word) const noexcept
+    {
+        std::uint64_t hash{ 14695981039346656037ull };
+
+        for (std::size_t i{}; i != word.size(); ++i) {
+            const char ch{ (i == 0) ? foldFirst(word[0]) : word[i] };
+            hash = (hash ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+        }
+
+        return static_cast<std::size_t>(hash);
+    }
+
+    bool WordEqual::operator()(std::string_view lhs, std::string_view rhs) const noexcept
+    {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        if (lhs.empty()) {
+            return true;
+        }
+
+        return foldFirst(lhs[0]) == foldFirst(rhs[0]) && std::memcmp(lhs.data() + 1, rhs.data() + 1, lhs.size() - 1) == 0;
+    }
+
+    // =======================================================================
+    // c'tor
+
+    Engine::Engine(std::string_view fileName)
+        : m_file{}, m_frequencies{}, m_totalWords{}
+    {
+        // an empty file can't be mapped - it is an empty text, no error
+        std::error_code error{};
+        if (std::filesystem::file_size(fileName, error) == 0 && !error) {
+            return;
+        }
+
+        if (!m_file.open(fileName)) {
+            throw std::invalid_argument{ "Unable to map file" };
+        }
+
+        m_file.adviseSequential();
+    }
+
+    // =======================================================================
+    // stages
+
+    std::vector<std::size_t> Engine::split(std::string_view text, std::size_t numChunks)
+    {
+        std::vector<std::size_t> bounds{ 0 };
+
+        for (std::size_t i{ 1 }; i < numChunks; ++i) {
+
+            std::size_t pos{ std::max(bounds.back(), text.size() / numChunks * i) };
+
+            // move the boundary behind the word
+            while (pos != text.size() && isLetter(text[pos])) {
+                ++pos;
+            }
+
+            bounds.push_back(pos);
+        }
+
+        bounds.push_back(text.size());
+        return bounds;
+    }
+
+    std::size_t Engine::countWords(std::string_view text, WordMap& map)
+    {
+        std::size_t words{};
+
+        // the word boundaries are found 64 bytes at a time (SIMD classification)
+        SimdTokenizer::forEachWord(text, [&] (std::string_view word) {
+            ++map[word];
+            ++words;
+        });
+
+        return words;
+    }
+
+    void Engine::count(std::size_t numThreads)
+    {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        const std::string_view text{ m_file.view() };
+        const std::vector<std::size_t> bounds{ split(text, numThreads) };
+
+        std::vector<WordMap> maps(numThreads);
+        std::vector<std::size_t> words(numThreads);
+
+        // tokenize: one chunk per thread, each one with a map of its own
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::size_t i{ 1 }; i < numThreads; ++i) {
+                threads.emplace_back([&, i] () {
+                    words[i] = countWords(text.substr(bounds[i], bounds[i + 1] - bounds[i]), maps[i]);
+                });
+            }
+
+            words[0] = countWords(text.substr(bounds[0], bounds[1] - bounds[0]), maps[0]);
+        }
+
+        // merge: pairwise, in parallel - log2(numThreads) rounds
+        for (std::size_t step{ 1 }; step < numThreads; step *= 2) {
+
+            std::vector<std::jthread> threads;
+
+            for (std::size_t i{}; i + step < numThreads; i += 2 * step) {
+                threads.emplace_back([&, i, step] () {
+                    for (const auto& [word, frequency] : maps[i + step]) {
+                        maps[i][word] += frequency;
+                    }
+                    maps[i + step] = WordMap{};
+                });
+            }
+        }
+
+        m_frequencies = std::move(maps[0]);
+
+        m_totalWords = 0;
+        for (std::size_t count : words) {
+            m_totalWords += count;
+        }
+    }
+
+    std::vector<WordCount> Engine::topWords(std::size_t k) const
+    {
+        std::vector<std::pair<std::string_view, std::size_t>> entries{ m_frequencies.begin(), m_frequencies.end() };
+
+        k = std::min(k, entries.size());
+
+        std::partial_sort(entries.begin(), entries.begin() + k, entries.end(),
+            [] (const auto& a, const auto& b) { return a.second > b.second; }
+        );
+
+        std::vector<WordCount> result;
+        result.reserve(k);
+
+        for (std::size_t i{}; i != k; ++i) {
+
+            std::string word{ entries[i].first };
+            word[0] = foldFirst(word[0]);
+
+            result.push_back(WordCount{ std::move(word), entries[i].second });
+        }
+
+        return result;
+    }
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================
@@ -0,0 +1,164 @@
+// ===========================================================================
+// WordFrequencyEngine_Test.cpp // Performance Optimization Advanced
+// ===========================================================================
+
+#include "../LoggerUtility/ScopedTimer.h"
+
+#include "WordFrequencyEngine.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace WordFrequencyEngine_SimpleTest {
+
+    using namespace WordFrequency;
+
+    static void main_word_frequency_engine_01()
+    {
+        Engine engine{ "LoremIpsumSmall.txt" };
+
+        engine.count(1);
+        const WordMap single{ engine.frequencies() };
+
+        engine.count(4);
+
+        std::println("{} bytes - {} words - {} unique words - same result with 1 and 4 threads: {}",
+            engine.fileSize(), engine.totalWords(), engine.uniqueWords(), single == engine.frequencies());
+
+        for (const auto& [word, count] : engine.topWords(5)) {
+            std::println("{:<5}: {}", count, word);
+        }
+    }
+
+    // chunk boundaries never split a word
+    static void main_word_frequency_engine_02()
+    {
+        std::string_view text{ "Lorem ipsum dolor sit amet, consectetur adipiscing elit." };
+
+        auto bounds{ Engine::split(text, 4) };
+
+        for (std::size_t i{}; i + 1 < bounds.size(); ++i) {
+            std::println("[{:>2}, {:>2}): \"{}\"", bounds[i], bounds[i + 1], text.substr(bounds[i], bounds[i + 1] - bounds[i]));
+        }
+    }
+
+    // an empty file is an empty text
+    static void main_word_frequency_engine_03()
+    {
+        const std::string fileName{ (std::filesystem::temp_directory_path() / "Empty.txt").string() };
+        std::ofstream{ fileName, std::ios::trunc };
+
+        Engine engine{ fileName };
+        engine.count(4);
+
+        std::println("{} bytes - {} words - {} unique words - {} top words",
+            engine.fileSize(), engine.totalWords(), engine.uniqueWords(), engine.topWords(5).size());
+
+        std::filesystem::remove(fileName);
+    }
+}
+
+namespace WordFrequencyEngine_Benchmark {
+
+    using namespace WordFrequency;
+
+    static constexpr std::string_view FileName{ "LoremIpsumHuge.txt" };
+
+#ifdef _DEBUG
+    static constexpr int Rounds = 1;         // debug
+#else
+    static constexpr int Rounds = 10;        // release
+#endif
+
+    // the approach of TextfileStatistics: std::getline, a std::string per word
+    static std::size_t countWithGetline()
+    {
+        std::unordered_map<std::string, std::size_t> frequenciesMap;
+
+        std::ifstream file{ FileName.data() };
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::string_view sv{ line };
+
+            std::size_t begin{};
+            std::size_t end{};
+
+            while (end != sv.size()) {
+
+                while (end != sv.size() && std::isalpha(sv[end]))
+                    ++end;
+
+                std::string s{ sv.substr(begin, end - begin) };
+                if (!s.empty() && std::isupper(s[0])) {
+                    s[0] = static_cast<char>(std::tolower(s[0]));
+                }
+
+                frequenciesMap[s]++;
+
+                while (end != sv.size() && (sv[end] == ' ' || sv[end] == '.' || sv[end] == ','))
+                    ++end;
+
+                begin = end;
+            }
+        }
+
+        return frequenciesMap.size();
+    }
+
+    template <typename TFunc>
+    static void measure(std::string_view name, std::size_t bytes, TFunc func)
+    {
+        const auto begin{ std::chrono::steady_clock::now() };
+
+        for (int round{}; round != Rounds; ++round) {
+            func();
+        }
+
+        const std::chrono::duration<double> seconds{ std::chrono::steady_clock::now() - begin };
+
+        std::println("{:<28}{:>10.1f} ms{:>10.1f} MB/s", name,
+            seconds.count() * 1'000.0 / Rounds, bytes * Rounds / seconds.count() / (1'024.0 * 1'024.0));
+    }
+
+    static void main_word_frequency_engine_20()
+    {
+        Engine engine{ FileName };
+
+        std::println("{}: {} bytes, {} rounds - {} cores", FileName, engine.fileSize(), Rounds, std::thread::hardware_concurrency());
+
+        measure("std::getline", engine.fileSize(), [] () { countWithGetline(); });
+
+        for (std::size_t threads : { 1, 2, 4, 8 }) {
+            measure(std::format("Engine, {} thread(s)", threads), engine.fileSize(), [&] () { engine.count(threads); });
+        }
+
+        for (const auto& [word, count] : engine.topWords(3)) {
+            std::println("{:<5}: {}", count, word);
+        }
+    }
+}
+
+void main_word_frequency_engine()
+{
+    WordFrequencyEngine_SimpleTest::main_word_frequency_engine_01();
+    WordFrequencyEngine_SimpleTest::main_word_frequency_engine_02();
+    WordFrequencyEngine_SimpleTest::main_word_frequency_engine_03();
+
+    WordFrequencyEngine_Benchmark::main_word_frequency_engine_20();
+}
+
+// ===========================================================================
+// End-of-File
+// ===========================================================================